@@ -0,0 +1,250 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <numbers>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "ComplexCharacterization.h"
+#include "ComplexPerf.h"
+#include "ComplexFFT.h"
+#include "ComplexFFT2D.h"
+#include "ComplexReduce.h"
+#include "ComplexRandom.h"
+#include "ComplexEscapeTime.h"
+#include "ComplexBFP.h"
+#include "ComplexBatch.h"
+
+// Characterizes the default functors against a few cheaper replacements and prints the Pareto frontier per function,
+// compares the batch polar conversions with the default and the polynomial functors, then runs a set of library
+// kernels under hardware performance counters (see ComplexPerf.h). Meaningful numbers need a Release build.
+// Usage: ComplexBench [samples] [repetitions] [perf json output]
+
+namespace
+{
+    // Odd Taylor polynomial after reduction to [-pi/2, pi/2].
+    template <class T>
+    struct taylor_sin
+    {
+        [[nodiscard]] T operator()(T _in) const noexcept
+        {
+            T tX = _in - 2 * std::numbers::pi_v<T> * std::nearbyint(_in / (2 * std::numbers::pi_v<T>));
+            if (tX > std::numbers::pi_v<T> / 2)
+                tX = std::numbers::pi_v<T> - tX;
+            else if (tX < -std::numbers::pi_v<T> / 2)
+                tX = -std::numbers::pi_v<T> - tX;
+            const T tX2 = tX * tX;
+            return tX * (T(1) + tX2 * (T(-1) / 6 + tX2 * (T(1) / 120 + tX2 * (T(-1) / 5040 + tX2 * (T(1) / 362880)))));
+        }
+    };
+
+    // Evaluates in float regardless of T.
+    template <class T>
+    struct narrow_sin
+    {
+        [[nodiscard]] T operator()(T _in) const noexcept { return static_cast<T>(std::sin(static_cast<float>(_in))); }
+    };
+
+    template <class T>
+    struct narrow_sqrt
+    {
+        [[nodiscard]] T operator()(T _in) const noexcept { return static_cast<T>(std::sqrt(static_cast<float>(_in))); }
+    };
+
+    // Bit level inverse square root estimate refined by two Newton steps.
+    template <class T>
+    struct newton_sqrt
+    {
+        [[nodiscard]] T operator()(T _in) const noexcept
+        {
+            const float tIn = static_cast<float>(_in);
+            std::uint32_t tBits;
+            std::memcpy(&tBits, &tIn, sizeof(tBits));
+            tBits = 0x5F375A86u - (tBits >> 1);
+            float tInverse;
+            std::memcpy(&tInverse, &tBits, sizeof(tInverse));
+            T tY = tInverse;
+            tY = tY * (T(1.5) - T(0.5) * _in * tY * tY);
+            tY = tY * (T(1.5) - T(0.5) * _in * tY * tY);
+            return _in == 0 ? T(0) : _in * tY;
+        }
+    };
+
+    // Rational approximation x / (1 + 0.28125 x^2) with reflection for |x| > 1.
+    template <class T>
+    struct rational_atan
+    {
+        [[nodiscard]] T operator()(T _in) const noexcept
+        {
+            const T tX = std::abs(_in) > 1 ? T(1) / _in : _in;
+            const T tAtan = tX / (T(1) + T(0.28125) * tX * tX);
+            if (std::abs(_in) <= 1)
+                return tAtan;
+            return (_in > 0 ? std::numbers::pi_v<T> / 2 : -std::numbers::pi_v<T> / 2) - tAtan;
+        }
+    };
+
+    template <class T>
+    T pointerSin(T _in) noexcept
+    {
+        return std::sin(_in);
+    }
+
+    template <typename T>
+    void characterizeType(const std::string &_type, std::size_t _samples, std::size_t _repetitions)
+    {
+        const long double tPi = std::numbers::pi_v<long double>;
+        const auto tSinReference = [](long double _x) { return std::sin(_x); };
+        const auto tSqrtReference = [](long double _x) { return std::sqrt(_x); };
+        const auto tAtanReference = [](long double _x) { return std::atan(_x); };
+
+        std::cout << "== " << _type << " defaults ==\n";
+        const auto tDefaults = characterizeFunctorSet<T>(_type, _samples, _repetitions);
+        writeCharacterizationReport(std::cout, tDefaults, false);
+
+        std::cout << "\n== " << _type << " sin ==\n";
+        const std::vector<FunctorCharacterization> tSin = {
+            characterizeFunctor<T>(_type + ".default_sin", default_sin<T>{}, tSinReference, {-tPi, tPi, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".pointer_sin", &pointerSin<T>, tSinReference, {-tPi, tPi, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".taylor_sin", taylor_sin<T>{}, tSinReference, {-tPi, tPi, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".poly_sin", poly_sin<T>{}, tSinReference, {-tPi, tPi, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".narrow_sin", narrow_sin<T>{}, tSinReference, {-tPi, tPi, _samples}, _repetitions)};
+        writeCharacterizationReport(std::cout, tSin);
+
+        std::cout << "\n== " << _type << " sqrt ==\n";
+        const std::vector<FunctorCharacterization> tSqrt = {
+            characterizeFunctor<T>(_type + ".default_sqrt", default_sqrt<T>{}, tSqrtReference, {0, 1e6L, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".newton_sqrt", newton_sqrt<T>{}, tSqrtReference, {0, 1e6L, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".narrow_sqrt", narrow_sqrt<T>{}, tSqrtReference, {0, 1e6L, _samples}, _repetitions)};
+        writeCharacterizationReport(std::cout, tSqrt);
+
+        std::cout << "\n== " << _type << " atan ==\n";
+        const std::vector<FunctorCharacterization> tAtan = {
+            characterizeFunctor<T>(_type + ".default_atan", default_atan<T>{}, tAtanReference, {-1e2L, 1e2L, _samples}, _repetitions),
+            characterizeFunctor<T>(_type + ".rational_atan", rational_atan<T>{}, tAtanReference, {-1e2L, 1e2L, _samples}, _repetitions)};
+        writeCharacterizationReport(std::cout, tAtan);
+        std::cout << '\n';
+    }
+
+    // toPolar/fromPolar throughput with the libm backed default functors and with the vectorizable poly_* functors.
+    template <typename T>
+    void comparePolar(const std::string &_type, std::size_t _samples, std::size_t _repetitions)
+    {
+        std::vector<T> tRe(_samples);
+        std::vector<T> tImg(_samples);
+        for (std::size_t i = 0; i < _samples; ++i)
+        {
+            tRe[i] = static_cast<T>(std::cos(0.37 * static_cast<double>(i)) * (1.0 + static_cast<double>(i % 1000)));
+            tImg[i] = static_cast<T>(std::sin(1.13 * static_cast<double>(i)) * (1.0 + static_cast<double>(i % 1000)));
+        }
+        std::vector<T> tAbs(_samples);
+        std::vector<T> tPhi(_samples);
+
+        const double tToDefault = measureBestSeconds(_repetitions, [&]()
+                                                     { toPolar<T>(tRe, tImg, tAbs, tPhi); });
+        const double tToPoly = measureBestSeconds(_repetitions, [&]()
+                                                  { toPolar<T>(tRe, tImg, tAbs, tPhi, default_sqrt<T>{}, poly_atan2<T>{}); });
+        const double tFromDefault = measureBestSeconds(_repetitions, [&]()
+                                                       { fromPolar<T>(tAbs, tPhi, tRe, tImg); });
+        const double tFromPoly = measureBestSeconds(_repetitions, [&]()
+                                                    { fromPolar<T>(tAbs, tPhi, tRe, tImg, poly_sin<T>{}, poly_cos<T>{}); });
+
+        const auto tRate = [&](double _seconds)
+        { return static_cast<double>(_samples) / std::max(_seconds, std::numeric_limits<double>::min()) * 1e-6; };
+        std::cout << "== " << _type << " polar conversions (Msamples/s) ==\n"
+                  << std::left << std::setw(12) << "kernel" << std::right << std::setw(12) << "default" << std::setw(12) << "poly" << std::setw(12) << "speedup" << '\n'
+                  << std::setprecision(4)
+                  << std::left << std::setw(12) << "toPolar" << std::right << std::setw(12) << tRate(tToDefault) << std::setw(12) << tRate(tToPoly) << std::setw(12) << tToDefault / tToPoly << '\n'
+                  << std::left << std::setw(12) << "fromPolar" << std::right << std::setw(12) << tRate(tFromDefault) << std::setw(12) << tRate(tFromPoly) << std::setw(12) << tFromDefault / tFromPoly << "\n\n";
+    }
+
+    void runKernels(std::size_t _samples)
+    {
+        std::vector<double> tRe(_samples);
+        std::vector<double> tImg(_samples);
+        PhiloxStream tStream(1);
+        generateComplexGaussian(ComplexSplitSpan<double>(tRe, tImg), tStream);
+
+        {
+            // User marked region around plain Complex arithmetic.
+            PerfRegion tRegion("bench.complexMultiply", _samples);
+            Complex<double> tProduct(1, 0);
+            for (std::size_t i = 0; i < _samples; ++i)
+                tProduct = tProduct * Complex<double>(tRe[i], tImg[i]) / Complex<double>(tRe[i], tImg[i]);
+            volatile double tSink = tProduct.getReal();
+            static_cast<void>(tSink);
+        }
+
+        {
+            // 1D transforms are too short to be marked one by one, the whole batch is one region.
+            const FFTPlan<double> tPlan(1024);
+            PerfRegion tRegion("bench.fft", _samples / 1024 * 1024);
+            for (std::size_t tFirst = 0; tFirst + 1024 <= _samples; tFirst += 1024)
+                tPlan.transform(tRe.data() + tFirst, tImg.data() + tFirst, FFTDirection::Forward);
+        }
+        if (_samples >= 256 * 256)
+            FFT2DPlan<double>(256, 256).transform(ComplexSplitSpan<double>(tRe.data(), tImg.data(), 256 * 256), FFTDirection::Forward);
+
+        volatile double tSink = reduceSum(ComplexSplitSpan<const double>(tRe, tImg)).getReal();
+        static_cast<void>(tSink);
+
+        std::vector<std::uint32_t> tIterations(512 * 512);
+        escapeTimeGrid(Complex<double>(-2, -1.5), 3.0 / 512, 512, 512, tIterations);
+
+        std::vector<float> tFloatRe(tRe.begin(), tRe.end());
+        std::vector<float> tFloatImg(tImg.begin(), tImg.end());
+        BFPEncoder<float> tEncoder;
+        tEncoder.push(ComplexSplitSpan<const float>(tFloatRe, tFloatImg));
+        tEncoder.flush();
+        BFPDecoder<float>(tEncoder.getData()).decode(ComplexSplitSpan<float>(tFloatRe, tFloatImg));
+    }
+
+    void writeKernelReport()
+    {
+        std::cout << "== kernel counters (all threads) ==\n";
+        if (!perfThreadCounters().isAvailable())
+            std::cout << "hardware counters not available, only timings are reported\n";
+        std::cout << std::left << std::setw(24) << "region" << std::right << std::setw(10) << "calls" << std::setw(12) << "elements"
+                  << std::setw(10) << "ns/elem" << std::setw(8) << "IPC" << std::setw(12) << "cycles/elem" << std::setw(12) << "cmiss/elem"
+                  << std::setw(12) << "bmiss/elem" << std::setw(12) << "assist/elem" << '\n';
+
+        std::vector<std::string> tRegions;
+        for (const auto &tResult : PerfRegistry::instance().getResults())
+            if (tRegions.empty() || tRegions.back() != tResult.region)
+                tRegions.push_back(tResult.region);
+        for (const auto &tRegion : tRegions)
+        {
+            const auto tTotal = PerfRegistry::instance().getTotal(tRegion);
+            std::cout << std::left << std::setw(24) << tRegion << std::right << std::setprecision(3) << std::setw(10) << tTotal.calls << std::setw(12) << tTotal.elements
+                      << std::setw(10) << tTotal.nanosecondsPerElement() << std::setw(8) << tTotal.ipc() << std::setw(12) << tTotal.perElement(PerfEvent::Cycles)
+                      << std::setw(12) << tTotal.perElement(PerfEvent::CacheMisses) << std::setw(12) << tTotal.perElement(PerfEvent::BranchMisses)
+                      << std::setw(12) << tTotal.perElement(PerfEvent::FPAssists) << '\n';
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t tSamples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::size_t{1} << 20;
+    const std::size_t tRepetitions = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+
+    characterizeType<float>("float", tSamples, tRepetitions);
+    characterizeType<double>("double", tSamples, tRepetitions);
+    comparePolar<float>("float", tSamples, tRepetitions);
+    comparePolar<double>("double", tSamples, tRepetitions);
+
+    PerfRegistry::instance().reset();
+    runKernels(tSamples);
+    writeKernelReport();
+    if (argc > 3)
+    {
+        std::ofstream tJson(argv[3]);
+        PerfRegistry::instance().writeJson(tJson);
+    }
+    return EXIT_SUCCESS;
+}
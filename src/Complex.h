@@ -2,6 +2,8 @@
 
 #include <string>
 #include <cmath>
+#include <complex>
+#include <charconv>
 
 template<class T>
 struct default_sin
@@ -57,6 +59,17 @@ struct default_atan
     }
 };
 
+template <class T>
+struct default_atan2
+{
+    static_assert(!std::is_function_v<T>, "default_atan2 cannot be instantiated for function types");
+    constexpr default_atan2() noexcept = default;
+    [[nodiscard]] constexpr T operator()(T _y, T _x) const noexcept
+    {
+        return std::atan2(_y, _x);
+    }
+};
+
 template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>, class POW2 = default_pow2<T>, class SQRT = default_sqrt<T>, class ATAN = default_atan<T>>
 class Complex
 {
@@ -101,6 +114,13 @@ public:
             this->calculateCartesianValues();
     }
 
+    constexpr Complex(const std::complex<T> &_complex) noexcept(std::is_nothrow_constructible_v<T>)
+        : Complex(_complex.real(), _complex.imag())
+    {
+    }
+
+    explicit constexpr operator std::complex<T>() const noexcept(std::is_nothrow_constructible_v<T>) { return std::complex<T>(this->re, this->img); }
+
     [[nodiscard]] constexpr const T &getReal() const noexcept { return this->re; }
     [[nodiscard]] constexpr const T &getImaginary() const noexcept { return this->img; }
     [[nodiscard]] constexpr const T &getAbsolute() const noexcept { return this->abs; }
@@ -150,6 +170,53 @@ public:
         }
     }
 
+    // Same text as toString(), built in a single string from _allocator (e.g. std::pmr::polymorphic_allocator<char>)
+    // without the intermediate std::string temporaries.
+    template <class Allocator>
+    [[nodiscard]] std::basic_string<char, std::char_traits<char>, Allocator> toString(const Allocator &_allocator) const noexcept(false)
+    {
+        return Complex<T, SIN, COS, POW2, SQRT, ATAN>::toString(*this, _allocator);
+    }
+    template <class Allocator>
+    [[nodiscard]] static std::basic_string<char, std::char_traits<char>, Allocator> toString(const Complex &_complex, const Allocator &_allocator) noexcept(false)
+    {
+        std::basic_string<char, std::char_traits<char>, Allocator> tResult(_allocator);
+        const auto tAppend = [&tResult](const T &_value)
+        {
+            char tBuffer[128];
+            std::to_chars_result tConverted;
+            if constexpr (std::is_floating_point_v<T>)
+                tConverted = std::to_chars(tBuffer, tBuffer + sizeof(tBuffer), _value, std::chars_format::fixed, 6);
+            else
+                tConverted = std::to_chars(tBuffer, tBuffer + sizeof(tBuffer), _value);
+            if (tConverted.ec == std::errc{})
+                tResult.append(tBuffer, tConverted.ptr);
+            else
+                tResult.append(std::to_string(_value));
+        };
+
+        tResult.append("Cartesian: ");
+        tAppend(_complex.getReal());
+        if (_complex.getImaginary() < 0)
+        {
+            tResult.append(" -j ");
+            tAppend(_complex.getImaginary() * (-1));
+        }
+        else
+        {
+            tResult.append(" +j ");
+            tAppend(_complex.getImaginary());
+        }
+        tResult.append("\nPolar: ");
+        tAppend(_complex.getAbsolute());
+        tResult.append("(cos(");
+        tAppend(_complex.getPhi());
+        tResult.append("°) +j sin(");
+        tAppend(_complex.getPhi());
+        tResult.append("°))");
+        return tResult;
+    }
+
     constexpr Complex<T, SIN, COS, POW2, SQRT, ATAN> &conjugate(void) noexcept(std::is_nothrow_copy_assignable_v<T> &&std::is_nothrow_move_assignable_v<T>)
     {
         this->img *= (-1);
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Block floating point codec for complex sample streams.
+// Samples are cut into blocks of blockSize samples. Every block stores one shared power of two and signed
+// mantissaBits wide integers for all real parts followed by all imaginary parts, packed without padding
+// (12 bits per component: 3 bytes per sample instead of 8 for Complex<float>). Blocks that cannot be represented
+// (non finite values, exponent out of range, or in lossless mode any value that does not survive the round trip)
+// and blocks that would not get smaller are stored raw.
+// Quantization rounds with a bias add and a truncating conversion instead of a libm call, so GCC vectorizes it at
+// -O3 like the dequantization loop; the block scan, the lossless check and the bit packing stay scalar.
+// Every block starts with a self describing header, so the decoder rebuilds the block index with one pass over the
+// headers and then decodes any block on its own, or all blocks in parallel.
+//
+// Block header (6 bytes, little endian):
+//   uint8  mode          0: quantized, 1: raw
+//   uint8  mantissaBits  (0 for raw blocks)
+//   uint16 sampleCount
+//   int16  shift         value = mantissa * 2^shift
+// Raw blocks store sampleCount real parts followed by sampleCount imaginary parts in native representation,
+// so the decoder has to use the same T as the encoder.
+
+constexpr std::size_t kBFPHeaderSize = 6;
+constexpr std::size_t kBFPMaxBlockSize = 65535;
+
+enum class BFPBlockMode : std::uint8_t
+{
+    Quantized = 0,
+    Raw = 1
+};
+
+struct BFPOptions
+{
+    std::size_t blockSize = 256;
+    // 2 ... 32 bits per real and imaginary part, including the sign
+    unsigned mantissaBits = 12;
+    // Blocks that are not reproduced exactly are stored raw.
+    bool lossless = false;
+};
+
+// Appends _count signed values of _bits bits each to _out, LSB first.
+inline void bfpPackBits(const std::int32_t *_values, std::size_t _count, unsigned _bits, std::uint8_t *_out) noexcept
+{
+    const std::uint64_t tMask = (std::uint64_t{1} << _bits) - 1;
+    std::uint64_t tAccumulator = 0;
+    unsigned tFill = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        tAccumulator |= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_values[i])) & tMask) << tFill;
+        tFill += _bits;
+        while (tFill >= 8)
+        {
+            *_out++ = static_cast<std::uint8_t>(tAccumulator);
+            tAccumulator >>= 8;
+            tFill -= 8;
+        }
+    }
+    if (tFill > 0)
+        *_out = static_cast<std::uint8_t>(tAccumulator);
+}
+
+inline void bfpUnpackBits(const std::uint8_t *_in, std::size_t _count, unsigned _bits, std::int32_t *_values) noexcept
+{
+    const std::uint64_t tMask = (std::uint64_t{1} << _bits) - 1;
+    const std::uint64_t tSign = std::uint64_t{1} << (_bits - 1);
+    std::uint64_t tAccumulator = 0;
+    unsigned tFill = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+        while (tFill < _bits)
+        {
+            tAccumulator |= static_cast<std::uint64_t>(*_in++) << tFill;
+            tFill += 8;
+        }
+        const std::uint64_t tValue = tAccumulator & tMask;
+        _values[i] = static_cast<std::int32_t>(static_cast<std::int64_t>(tValue ^ tSign) - static_cast<std::int64_t>(tSign));
+        tAccumulator >>= _bits;
+        tFill -= _bits;
+    }
+}
+
+[[nodiscard]] constexpr std::size_t bfpPackedSize(std::size_t _count, unsigned _bits) noexcept
+{
+    return (_count * _bits + 7) / 8;
+}
+
+// Streaming encoder: push samples in any amount, every completed block is appended to getData() and indexed in getOffsets().
+template <typename T>
+class BFPEncoder
+{
+    static_assert(std::is_floating_point_v<T>, "BFPEncoder: T must be a floating point type");
+
+private:
+    BFPOptions mOptions;
+    std::pmr::vector<std::uint8_t> mData;
+    std::pmr::vector<std::uint64_t> mOffsets;
+    std::pmr::vector<T> mPendingRe;
+    std::pmr::vector<T> mPendingImg;
+    std::pmr::vector<std::int32_t> mMantissas;
+    std::size_t mSamples = 0;
+    std::size_t mRawBlocks = 0;
+
+    void writeHeader(BFPBlockMode _mode, unsigned _bits, std::size_t _count, int _shift) noexcept(false)
+    {
+        const auto tCount = static_cast<std::uint16_t>(_count);
+        const auto tShift = static_cast<std::uint16_t>(static_cast<std::int16_t>(_shift));
+        const std::uint8_t tHeader[kBFPHeaderSize] = {static_cast<std::uint8_t>(_mode), static_cast<std::uint8_t>(_bits),
+                                                      static_cast<std::uint8_t>(tCount), static_cast<std::uint8_t>(tCount >> 8),
+                                                      static_cast<std::uint8_t>(tShift), static_cast<std::uint8_t>(tShift >> 8)};
+        mData.insert(mData.end(), tHeader, tHeader + kBFPHeaderSize);
+    }
+
+    void writeRaw(const T *_re, const T *_img, std::size_t _count) noexcept(false)
+    {
+        writeHeader(BFPBlockMode::Raw, 0, _count, 0);
+        const std::size_t tStart = mData.size();
+        mData.resize(tStart + 2 * _count * sizeof(T));
+        std::memcpy(mData.data() + tStart, _re, _count * sizeof(T));
+        std::memcpy(mData.data() + tStart + _count * sizeof(T), _img, _count * sizeof(T));
+        ++mRawBlocks;
+    }
+
+    // Returns false if the block has to be stored raw.
+    [[nodiscard]] bool quantize(const T *_re, const T *_img, std::size_t _count, int &_shift) noexcept
+    {
+        const unsigned tBits = mOptions.mantissaBits;
+        T tMax = 0;
+        bool tFinite = true;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            tMax = std::max(tMax, std::max(std::abs(_re[i]), std::abs(_img[i])));
+            tFinite &= std::isfinite(_re[i]) & std::isfinite(_img[i]);
+        }
+        if (!tFinite)
+            return false;
+
+        int tExponent = 0;
+        if (tMax != 0)
+            static_cast<void>(std::frexp(tMax, &tExponent));
+        _shift = tMax == 0 ? 0 : tExponent - static_cast<int>(tBits - 1);
+        const double tScale = std::ldexp(1.0, -_shift);
+        const double tInverse = std::ldexp(1.0, _shift);
+        if (_shift < INT16_MIN || _shift > INT16_MAX || !std::isfinite(tScale) || tInverse == 0)
+            return false;
+
+        const double tLimit = std::ldexp(1.0, static_cast<int>(tBits - 1)) - 1;
+        std::int32_t *tRe = mMantissas.data();
+        std::int32_t *tImg = mMantissas.data() + _count;
+        // Round half away from zero by adding a signed bias and truncating in the integer conversion:
+        // |value * tScale| < 2^(tBits - 1), so the clamped sum always fits the mantissa.
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+            const double tScaledRe = static_cast<double>(_re[i]) * tScale;
+            const double tScaledImg = static_cast<double>(_img[i]) * tScale;
+            tRe[i] = static_cast<std::int32_t>(std::clamp(tScaledRe + std::copysign(0.5, tScaledRe), -tLimit, tLimit));
+            tImg[i] = static_cast<std::int32_t>(std::clamp(tScaledImg + std::copysign(0.5, tScaledImg), -tLimit, tLimit));
+        }
+
+        if (mOptions.lossless)
+        {
+            bool tExact = true;
+            for (std::size_t i = 0; i < _count; ++i)
+                tExact &= (static_cast<T>(tRe[i] * tInverse) == _re[i]) & (static_cast<T>(tImg[i] * tInverse) == _img[i]);
+            if (!tExact)
+                return false;
+        }
+        return true;
+    }
+
+    void encodeBlock(const T *_re, const T *_img, std::size_t _count) noexcept(false)
+    {
+        mOffsets.push_back(mData.size());
+        mSamples += _count;
+
+        const std::size_t tPacked = bfpPackedSize(2 * _count, mOptions.mantissaBits);
+        int tShift = 0;
+        if (tPacked >= 2 * _count * sizeof(T) || !quantize(_re, _img, _count, tShift))
+        {
+            writeRaw(_re, _img, _count);
+            return;
+        }
+        writeHeader(BFPBlockMode::Quantized, mOptions.mantissaBits, _count, tShift);
+        const std::size_t tStart = mData.size();
+        mData.resize(tStart + tPacked);
+        bfpPackBits(mMantissas.data(), 2 * _count, mOptions.mantissaBits, mData.data() + tStart);
+    }
+
+public:
+    explicit BFPEncoder(const BFPOptions &_options = {}, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mOptions(_options), mData(_resource), mOffsets(_resource), mPendingRe(_resource), mPendingImg(_resource), mMantissas(2 * _options.blockSize, _resource)
+    {
+        if (_options.blockSize == 0 || _options.blockSize > kBFPMaxBlockSize)
+            throw std::invalid_argument("BFPEncoder: block size must be in [1, 65535]");
+        if (_options.mantissaBits < 2 || _options.mantissaBits > 32)
+            throw std::invalid_argument("BFPEncoder: mantissa bits must be in [2, 32]");
+        mPendingRe.reserve(_options.blockSize);
+        mPendingImg.reserve(_options.blockSize);
+    }
+
+    template <ComplexReadableView IN>
+    void push(const IN &_in) noexcept(false)
+    {
+        for (std::size_t i = 0; i < _in.size(); ++i)
+        {
+            mPendingRe.push_back(_in.real(i));
+            mPendingImg.push_back(_in.imag(i));
+            if (mPendingRe.size() == mOptions.blockSize)
+            {
+                encodeBlock(mPendingRe.data(), mPendingImg.data(), mOptions.blockSize);
+                mPendingRe.clear();
+                mPendingImg.clear();
+            }
+        }
+    }
+
+    // Encodes the remaining samples as a shorter final block.
+    void flush() noexcept(false)
+    {
+        if (mPendingRe.empty())
+            return;
+        encodeBlock(mPendingRe.data(), mPendingImg.data(), mPendingRe.size());
+        mPendingRe.clear();
+        mPendingImg.clear();
+    }
+
+    [[nodiscard]] std::span<const std::uint8_t> getData() const noexcept { return mData; }
+    // Byte offset of every encoded block in getData().
+    [[nodiscard]] std::span<const std::uint64_t> getOffsets() const noexcept { return mOffsets; }
+    [[nodiscard]] std::size_t getSampleCount() const noexcept { return mSamples; }
+    [[nodiscard]] std::size_t getBlockCount() const noexcept { return mOffsets.size(); }
+    [[nodiscard]] std::size_t getRawBlockCount() const noexcept { return mRawBlocks; }
+
+    // Drops the encoded data, e.g. after it has been written out; block offsets restart at 0.
+    void clear() noexcept
+    {
+        mData.clear();
+        mOffsets.clear();
+        mPendingRe.clear();
+        mPendingImg.clear();
+        mSamples = 0;
+        mRawBlocks = 0;
+    }
+};
+
+// Decoder over an encoded byte stream (not owned). The constructor walks the block headers once to build the index.
+template <typename T>
+class BFPDecoder
+{
+    static_assert(std::is_floating_point_v<T>, "BFPDecoder: T must be a floating point type");
+
+public:
+    struct BlockInfo
+    {
+        std::uint64_t offset = 0;
+        std::uint64_t firstSample = 0;
+        std::size_t sampleCount = 0;
+        BFPBlockMode mode = BFPBlockMode::Quantized;
+        unsigned mantissaBits = 0;
+        int shift = 0;
+    };
+
+private:
+    std::span<const std::uint8_t> mData;
+    std::pmr::vector<BlockInfo> mBlocks;
+    std::pmr::vector<std::int32_t> mMantissas;
+    std::size_t mSamples = 0;
+
+    template <ComplexWritableView OUT>
+    void decodeInto(std::size_t _block, const OUT &_out, std::size_t _first, std::int32_t *_mantissas) const noexcept
+    {
+        const BlockInfo &tInfo = mBlocks[_block];
+        const std::uint8_t *tPayload = mData.data() + tInfo.offset + kBFPHeaderSize;
+        const std::size_t tCount = tInfo.sampleCount;
+        if (tInfo.mode == BFPBlockMode::Raw)
+        {
+            for (std::size_t i = 0; i < tCount; ++i)
+            {
+                T tRe;
+                T tImg;
+                std::memcpy(&tRe, tPayload + i * sizeof(T), sizeof(T));
+                std::memcpy(&tImg, tPayload + (tCount + i) * sizeof(T), sizeof(T));
+                _out.set(_first + i, tRe, tImg);
+            }
+            return;
+        }
+
+        bfpUnpackBits(tPayload, 2 * tCount, tInfo.mantissaBits, _mantissas);
+        const double tInverse = std::ldexp(1.0, tInfo.shift);
+        for (std::size_t i = 0; i < tCount; ++i)
+            _out.set(_first + i, static_cast<T>(_mantissas[i] * tInverse), static_cast<T>(_mantissas[tCount + i] * tInverse));
+    }
+
+public:
+    explicit BFPDecoder(std::span<const std::uint8_t> _data, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mData(_data), mBlocks(_resource), mMantissas(_resource)
+    {
+        std::size_t tMaxCount = 0;
+        for (std::uint64_t tOffset = 0; tOffset < mData.size();)
+        {
+            if (mData.size() - tOffset < kBFPHeaderSize)
+                throw std::invalid_argument("BFPDecoder: truncated block header");
+            const std::uint8_t *tHeader = mData.data() + tOffset;
+            BlockInfo tInfo;
+            tInfo.offset = tOffset;
+            tInfo.firstSample = mSamples;
+            tInfo.mode = static_cast<BFPBlockMode>(tHeader[0]);
+            tInfo.mantissaBits = tHeader[1];
+            tInfo.sampleCount = static_cast<std::size_t>(tHeader[2]) | (static_cast<std::size_t>(tHeader[3]) << 8);
+            tInfo.shift = static_cast<std::int16_t>(static_cast<std::uint16_t>(tHeader[4] | (tHeader[5] << 8)));
+
+            std::size_t tPayload = 0;
+            if (tInfo.mode == BFPBlockMode::Raw)
+                tPayload = 2 * tInfo.sampleCount * sizeof(T);
+            else if (tInfo.mode == BFPBlockMode::Quantized && tInfo.mantissaBits >= 2 && tInfo.mantissaBits <= 32)
+                tPayload = bfpPackedSize(2 * tInfo.sampleCount, tInfo.mantissaBits);
+            else
+                throw std::invalid_argument("BFPDecoder: corrupt block header");
+            if (tInfo.sampleCount == 0 || mData.size() - tOffset - kBFPHeaderSize < tPayload)
+                throw std::invalid_argument("BFPDecoder: truncated block");
+
+            mBlocks.push_back(tInfo);
+            mSamples += tInfo.sampleCount;
+            tMaxCount = std::max(tMaxCount, tInfo.sampleCount);
+            tOffset += kBFPHeaderSize + tPayload;
+        }
+        mMantissas.resize(2 * tMaxCount);
+    }
+
+    [[nodiscard]] std::size_t getBlockCount() const noexcept { return mBlocks.size(); }
+    [[nodiscard]] std::size_t getSampleCount() const noexcept { return mSamples; }
+    [[nodiscard]] const BlockInfo &getBlockInfo(std::size_t _block) const noexcept(false) { return mBlocks.at(_block); }
+
+    // Decodes block _block into the first getBlockInfo(_block).sampleCount samples of _out and returns that count.
+    template <ComplexWritableView OUT>
+    std::size_t decodeBlock(std::size_t _block, const OUT &_out) noexcept(false)
+    {
+        if (_block >= mBlocks.size())
+            throw std::out_of_range("BFPDecoder: block index out of range");
+        if (_out.size() < mBlocks[_block].sampleCount)
+            throw std::invalid_argument("BFPDecoder: output too small for the block");
+        decodeInto(_block, _out, 0, mMantissas.data());
+        return mBlocks[_block].sampleCount;
+    }
+
+    // Decodes the whole stream, blocks are distributed over _threads threads (0: all hardware threads).
+    template <ComplexWritableView OUT>
+    void decode(const OUT &_out, std::size_t _threads = 0) const noexcept(false)
+    {
+        if (_out.size() != mSamples)
+            throw std::invalid_argument("BFPDecoder: output size does not match the sample count");
+        const std::size_t tScratch = mMantissas.size();
+        complexParallelFor(mBlocks.size(), _threads, [&](std::size_t _begin, std::size_t _end)
+                           {
+            COMPLEX_PERF_REGION("bfpDecode", mBlocks[_end - 1].firstSample + mBlocks[_end - 1].sampleCount - mBlocks[_begin].firstSample);
+            std::vector<std::int32_t> tMantissas(tScratch);
+            for (std::size_t b = _begin; b < _end; ++b)
+                decodeInto(b, _out, mBlocks[b].firstSample, tMantissas.data()); });
+    }
+};
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <span>
+#include <algorithm>
+#include <numbers>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+
+// Batch kernels working on complex views (see ComplexView.h) and plain component planes.
+// They never construct Complex objects, so no polar values are computed that are not asked for.
+// In contrast to Complex::calculatePolarValues() the phase is computed with a full-quadrant
+// atan2, so it is well defined for re == 0 and lies in [-pi, pi].
+// With the default functors every element costs a libm call, which GCC/Clang do not vectorize without
+// -ffast-math and a vector math library. poly_sin, poly_cos and poly_atan2 below are inlinable, branch free
+// replacements built from arithmetic, copysign, selects and integer conversions; passed as functors they let
+// GCC vectorize the phase loop of toPolar and the loop of fromPolar at -O3. The magnitude loop additionally
+// needs -fno-math-errno, std::sqrt keeps an errno branch otherwise. The bench target measures both variants.
+
+// Reduces _in to _in - k pi/2 with |r| <= pi/4 (Cody-Waite, three part pi/2), _quadrant is k mod 4.
+// Accurate for |_in| up to about 1e4 (float) or 1e8 (double).
+template <typename T>
+[[nodiscard]] constexpr T polyReduceHalfPi(T _in, std::int32_t &_quadrant) noexcept
+{
+    const T tScaled = _in * (2 / std::numbers::pi_v<T>);
+    // Round to nearest by bias and truncation, unlike std::nearbyint this maps to a vector conversion.
+    const auto tK = static_cast<std::int32_t>(tScaled + std::copysign(T(0.5), tScaled));
+    const T tKf = static_cast<T>(tK);
+    _quadrant = tK & 3;
+    if constexpr (std::numeric_limits<T>::digits <= 24)
+        return ((_in - tKf * T(1.5703125)) - tKf * T(4.837512969970703125e-4)) - tKf * T(7.54978995489188216e-8);
+    else
+        return ((_in - tKf * T(1.57079625129699707031)) - tKf * T(7.54978941586159635335e-8)) - tKf * T(5.39030285815811905290e-15);
+}
+
+// Taylor polynomials of sin and cos on [-pi/4, pi/4], truncated at the precision of T.
+template <typename T>
+[[nodiscard]] constexpr T polySinKernel(T _r) noexcept
+{
+    const T tR2 = _r * _r;
+    if constexpr (std::numeric_limits<T>::digits <= 24)
+        return _r + _r * tR2 * (T(-1.0 / 6) + tR2 * (T(1.0 / 120) + tR2 * (T(-1.0 / 5040) + tR2 * T(1.0 / 362880))));
+    else
+        return _r + _r * tR2 * (T(-1.0 / 6) + tR2 * (T(1.0 / 120) + tR2 * (T(-1.0 / 5040) + tR2 * (T(1.0 / 362880) + tR2 * (T(-1.0 / 39916800) + tR2 * (T(1.0 / 6227020800) + tR2 * T(-1.0 / 1307674368000)))))));
+}
+template <typename T>
+[[nodiscard]] constexpr T polyCosKernel(T _r) noexcept
+{
+    const T tR2 = _r * _r;
+    if constexpr (std::numeric_limits<T>::digits <= 24)
+        return T(1) + tR2 * (T(-0.5) + tR2 * (T(1.0 / 24) + tR2 * (T(-1.0 / 720) + tR2 * (T(1.0 / 40320) + tR2 * T(-1.0 / 3628800)))));
+    else
+        return T(1) + tR2 * (T(-0.5) + tR2 * (T(1.0 / 24) + tR2 * (T(-1.0 / 720) + tR2 * (T(1.0 / 40320) + tR2 * (T(-1.0 / 3628800) + tR2 * (T(1.0 / 479001600) + tR2 * (T(-1.0 / 87178291200) + tR2 * T(1.0 / 20922789888000))))))));
+}
+
+// Vectorizable sin and cos, the absolute error stays within a few ULP of 1 on the range of polyReduceHalfPi.
+template <typename T>
+struct poly_sin
+{
+    [[nodiscard]] constexpr T operator()(T _in) const noexcept
+    {
+        std::int32_t tQuadrant = 0;
+        const T tR = polyReduceHalfPi(_in, tQuadrant);
+        const T tValue = (tQuadrant & 1) != 0 ? polyCosKernel(tR) : polySinKernel(tR);
+        return (tQuadrant & 2) != 0 ? -tValue : tValue;
+    }
+};
+
+template <typename T>
+struct poly_cos
+{
+    [[nodiscard]] constexpr T operator()(T _in) const noexcept
+    {
+        std::int32_t tQuadrant = 0;
+        const T tR = polyReduceHalfPi(_in, tQuadrant);
+        const T tValue = (tQuadrant & 1) != 0 ? polySinKernel(tR) : polyCosKernel(tR);
+        return ((tQuadrant + 1) & 2) != 0 ? -tValue : tValue;
+    }
+};
+
+// Vectorizable full-quadrant atan2 within a few ULP of std::atan2 (Cephes atan/atanf kernels on min/max),
+// including the signs of zeros except that a zero _x counts as positive: atan2(+-0, -0) is +-0.
+// Both arguments infinite give NaN instead of an odd multiple of pi/4.
+// Every case split is a copysign or a select between constants: GCC threads comparisons feeding arithmetic
+// into branches and cannot if-convert those, as floating point operations may trap.
+template <typename T>
+struct poly_atan2
+{
+    [[nodiscard]] constexpr T operator()(T _y, T _x) const noexcept
+    {
+        const T tAbsX = std::abs(_x);
+        const T tAbsY = std::abs(_y);
+        // A zero maximum implies a zero minimum. std::min/max drop NaNs, the added term restores them.
+        const T tA = std::min(tAbsX, tAbsY) / std::max(std::max(tAbsX, tAbsY), std::numeric_limits<T>::min()) +
+                     (std::isunordered(_x, _y) ? std::numeric_limits<T>::quiet_NaN() : T(0));
+
+        // atan(a) = pi/4 + atan((a - 1) / (a + 1)) above the threshold, tReduce is 0 or 1.
+        T tAtan;
+        if constexpr (std::numeric_limits<T>::digits <= 24)
+        {
+            const T tReduce = T(0.5) + std::copysign(T(0.5), tA - T(0.41421356237309503));
+            const T tX = (tA - tReduce) / (T(1) + tReduce * tA);
+            const T tZ = tX * tX;
+            tAtan = tReduce * (std::numbers::pi_v<T> / 4) +
+                    ((((T(8.05374449538e-2) * tZ - T(1.38776856032e-1)) * tZ + T(1.99777106478e-1)) * tZ - T(3.33329491539e-1)) * tZ * tX + tX);
+        }
+        else
+        {
+            const T tReduce = T(0.5) + std::copysign(T(0.5), tA - T(0.66));
+            const T tX = (tA - tReduce) / (T(1) + tReduce * tA);
+            const T tZ = tX * tX;
+            const T tP = (((T(-8.750608600031904122785e-1) * tZ + T(-1.615753718733365076637e1)) * tZ + T(-7.500855792314704667340e1)) * tZ + T(-1.228866684490136173410e2)) * tZ + T(-6.485021904942025371773e1);
+            const T tQ = ((((tZ + T(2.485846490142306297962e1)) * tZ + T(1.650270098316988542046e2)) * tZ + T(4.328810604912902668951e2)) * tZ + T(4.853903996359136964868e2)) * tZ + T(1.945506571482613964425e2);
+            tAtan = tReduce * (std::numbers::pi_v<T> / 4 + T(0.5 * 6.123233995736765886130e-17)) + (tX * tZ * tP / tQ + tX);
+        }
+
+        // Mirror at pi/4 when |y| > |x|, at pi/2 when x < 0, at 0 when y < 0.
+        const T tOctant = (tAbsY > tAbsX ? std::numbers::pi_v<T> / 2 : T(0)) + std::copysign(tAtan, tAbsX - tAbsY);
+        const T tHalf = (_x < 0 ? std::numbers::pi_v<T> : T(0)) + std::copysign(tOctant, _x < 0 ? T(-1) : T(1));
+        return std::copysign(tHalf, _y);
+    }
+};
+
+// Samples per tile of toPolar, small enough for the tile copy to stay in L1.
+constexpr std::size_t kPolarTile = 256;
+
+// _abs and _phi may alias the real and imaginary planes of _in, e.g. to convert a buffer in place.
+template <ComplexReadableView IN, class SQRT = default_sqrt<typename IN::value_type>, class ATAN2 = default_atan2<typename IN::value_type>>
+constexpr void toPolar(const IN &_in, std::span<typename IN::value_type> _abs, std::span<typename IN::value_type> _phi, const SQRT &_sqrt = SQRT{}, const ATAN2 &_atan2 = ATAN2{}) noexcept(false)
+{
+    if (_abs.size() != _in.size() || _phi.size() != _in.size())
+        throw std::invalid_argument("toPolar: all planes must have the same size");
+
+    using T = typename IN::value_type;
+    auto *tAbs = _abs.data();
+    auto *tPhi = _phi.data();
+    const std::size_t tSize = _in.size();
+
+    // Every tile is loaded before its results are stored, so the output planes may alias the input planes, and the
+    // magnitude and phase loops stay separate, so either one vectorizes on its own.
+    for (std::size_t tFirst = 0; tFirst < tSize; tFirst += kPolarTile)
+    {
+        const std::size_t tCount = std::min(kPolarTile, tSize - tFirst);
+        T tRe[kPolarTile];
+        T tImg[kPolarTile];
+        for (std::size_t l = 0; l < tCount; ++l)
+        {
+            tRe[l] = _in.real(tFirst + l);
+            tImg[l] = _in.imag(tFirst + l);
+        }
+        for (std::size_t l = 0; l < tCount; ++l)
+            tAbs[tFirst + l] = _sqrt(tRe[l] * tRe[l] + tImg[l] * tImg[l]);
+        for (std::size_t l = 0; l < tCount; ++l)
+            tPhi[tFirst + l] = _atan2(tImg[l], tRe[l]);
+    }
+}
+
+template <typename T, class SQRT = default_sqrt<T>, class ATAN2 = default_atan2<T>>
+constexpr void toPolar(std::span<const T> _re, std::span<const T> _img, std::span<T> _abs, std::span<T> _phi, const SQRT &_sqrt = SQRT{}, const ATAN2 &_atan2 = ATAN2{}) noexcept(false)
+{
+    toPolar(ComplexSplitSpan<const T>(_re, _img), _abs, _phi, _sqrt, _atan2);
+}
+
+template <ComplexWritableView OUT, class SIN = default_sin<typename OUT::value_type>, class COS = default_cos<typename OUT::value_type>>
+constexpr void fromPolar(std::span<const typename OUT::value_type> _abs, std::span<const typename OUT::value_type> _phi, const OUT &_out, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    if (_phi.size() != _abs.size() || _out.size() != _abs.size())
+        throw std::invalid_argument("fromPolar: all planes must have the same size");
+
+    const auto *tAbs = _abs.data();
+    const auto *tPhi = _phi.data();
+    const std::size_t tSize = _abs.size();
+
+    for (std::size_t i = 0; i < tSize; ++i)
+    {
+        const auto tCos = _cos(tPhi[i]);
+        const auto tSin = _sin(tPhi[i]);
+        _out.set(i, tAbs[i] * tCos, tAbs[i] * tSin);
+    }
+}
+
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+constexpr void fromPolar(std::span<const T> _abs, std::span<const T> _phi, std::span<T> _re, std::span<T> _img, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    fromPolar(_abs, _phi, ComplexSplitSpan<T>(_re, _img), _sin, _cos);
+}
+
+// Element-wise arithmetic, _out may alias one of the inputs.
+
+template <ComplexReadableView LH, ComplexReadableView RH, ComplexWritableView OUT>
+constexpr void batchAdd(const LH &_lh, const RH &_rh, const OUT &_out) noexcept(false)
+{
+    if (_rh.size() != _lh.size() || _out.size() != _lh.size())
+        throw std::invalid_argument("batchAdd: views must have the same size");
+    for (std::size_t i = 0; i < _lh.size(); ++i)
+        _out.set(i, _lh.real(i) + _rh.real(i), _lh.imag(i) + _rh.imag(i));
+}
+
+template <ComplexReadableView LH, ComplexReadableView RH, ComplexWritableView OUT>
+constexpr void batchSubtract(const LH &_lh, const RH &_rh, const OUT &_out) noexcept(false)
+{
+    if (_rh.size() != _lh.size() || _out.size() != _lh.size())
+        throw std::invalid_argument("batchSubtract: views must have the same size");
+    for (std::size_t i = 0; i < _lh.size(); ++i)
+        _out.set(i, _lh.real(i) - _rh.real(i), _lh.imag(i) - _rh.imag(i));
+}
+
+template <ComplexReadableView LH, ComplexReadableView RH, ComplexWritableView OUT>
+constexpr void batchMultiply(const LH &_lh, const RH &_rh, const OUT &_out) noexcept(false)
+{
+    if (_rh.size() != _lh.size() || _out.size() != _lh.size())
+        throw std::invalid_argument("batchMultiply: views must have the same size");
+    for (std::size_t i = 0; i < _lh.size(); ++i)
+    {
+        const auto tRe = (_lh.real(i) * _rh.real(i)) - (_lh.imag(i) * _rh.imag(i));
+        const auto tImg = (_lh.real(i) * _rh.imag(i)) + (_lh.imag(i) * _rh.real(i));
+        _out.set(i, tRe, tImg);
+    }
+}
+
+template <ComplexReadableView IN, ComplexWritableView OUT>
+constexpr void batchScale(const IN &_in, const typename IN::value_type &_factor, const OUT &_out) noexcept(false)
+{
+    if (_out.size() != _in.size())
+        throw std::invalid_argument("batchScale: views must have the same size");
+    for (std::size_t i = 0; i < _in.size(); ++i)
+        _out.set(i, _in.real(i) * _factor, _in.imag(i) * _factor);
+}
+
+template <ComplexReadableView IN, ComplexWritableView OUT>
+constexpr void batchConjugate(const IN &_in, const OUT &_out) noexcept(false)
+{
+    if (_out.size() != _in.size())
+        throw std::invalid_argument("batchConjugate: views must have the same size");
+    for (std::size_t i = 0; i < _in.size(); ++i)
+        _out.set(i, _in.real(i), -_in.imag(i));
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <ostream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+#include "Complex.h"
+
+// Accuracy and speed characterization of the SIN/COS/POW2/SQRT/ATAN functors a Complex is instantiated with.
+// A functor is evaluated on an even grid over an input domain and compared against a long double reference
+// evaluated at the same (exactly representable) inputs; the error is measured in ULPs of T at the reference value.
+// Throughput runs independent calls over the whole grid, latency chains every call on the previous result,
+// both report the best of several repetitions. paretoFrontier() selects the candidates for which no other
+// candidate is both at least as accurate and at least as fast.
+
+struct CharacterizationDomain
+{
+    long double lower = 0;
+    long double upper = 1;
+    std::size_t samples = 1 << 16;
+};
+
+struct FunctorCharacterization
+{
+    std::string name;
+    long double maxUlp = 0;
+    long double meanUlp = 0;
+    // Input with the largest error.
+    long double worstInput = 0;
+    // Largest absolute error, more telling than ULPs close to zeros of the function.
+    long double maxAbsolute = 0;
+    // Independent calls per second.
+    double throughput = 0;
+    // Nanoseconds per call in a dependency chain.
+    double latency = 0;
+    std::size_t samples = 0;
+};
+
+// Error of _value in ULPs of T at _reference. Subnormal results use the ULP of the smallest normal binade.
+// The reference is only meaningful if long double is wider than T, which excludes double on targets where
+// long double is the same type as double (MSVC, AArch64 Apple).
+template <typename T>
+[[nodiscard]] long double ulpError(T _value, long double _reference) noexcept
+{
+    static_assert(std::numeric_limits<long double>::digits > std::numeric_limits<T>::digits, "ulpError: long double must be wider than T to serve as reference");
+
+    if (std::isnan(_value) || std::isnan(_reference))
+        return std::isnan(_value) && std::isnan(_reference) ? 0 : std::numeric_limits<long double>::infinity();
+    if (std::isinf(_value) || std::isinf(_reference))
+        return static_cast<long double>(_value) == _reference ? 0 : std::numeric_limits<long double>::infinity();
+
+    const int tExponent = _reference == 0 ? std::numeric_limits<T>::min_exponent - 1 : std::max(std::ilogb(_reference), std::numeric_limits<T>::min_exponent - 1);
+    const long double tUlp = std::ldexp(1.0L, tExponent - (std::numeric_limits<T>::digits - 1));
+    return std::abs(static_cast<long double>(_value) - _reference) / tUlp;
+}
+
+// Best wall clock time of _repetitions runs of _body in seconds.
+template <class BODY>
+[[nodiscard]] double measureBestSeconds(std::size_t _repetitions, const BODY &_body) noexcept(false)
+{
+    double tBest = std::numeric_limits<double>::infinity();
+    for (std::size_t r = 0; r < std::max<std::size_t>(1, _repetitions); ++r)
+    {
+        const auto tStart = std::chrono::steady_clock::now();
+        _body();
+        const std::chrono::duration<double> tElapsed = std::chrono::steady_clock::now() - tStart;
+        tBest = std::min(tBest, tElapsed.count());
+    }
+    return tBest;
+}
+
+// Characterizes the unary functor _function against _reference over _domain.
+template <typename T, class FUNCTION, class REFERENCE>
+[[nodiscard]] FunctorCharacterization characterizeFunctor(std::string _name, const FUNCTION &_function, const REFERENCE &_reference, const CharacterizationDomain &_domain, std::size_t _repetitions = 5) noexcept(false)
+{
+    if (_domain.samples < 2 || !(_domain.lower < _domain.upper))
+        throw std::invalid_argument("characterizeFunctor: domain needs at least 2 samples and lower < upper");
+
+    FunctorCharacterization tResult;
+    tResult.name = std::move(_name);
+    tResult.samples = _domain.samples;
+
+    std::vector<T> tInputs(_domain.samples);
+    for (std::size_t i = 0; i < tInputs.size(); ++i)
+        tInputs[i] = static_cast<T>(_domain.lower + (_domain.upper - _domain.lower) * static_cast<long double>(i) / static_cast<long double>(tInputs.size() - 1));
+
+    long double tSum = 0;
+    for (const T tInput : tInputs)
+    {
+        const T tValue = _function(tInput);
+        const long double tReference = _reference(static_cast<long double>(tInput));
+        const long double tError = ulpError<T>(tValue, tReference);
+        tSum += tError;
+        tResult.maxAbsolute = std::max(tResult.maxAbsolute, std::abs(static_cast<long double>(tValue) - tReference));
+        if (tError > tResult.maxUlp)
+        {
+            tResult.maxUlp = tError;
+            tResult.worstInput = tInput;
+        }
+    }
+    tResult.meanUlp = tSum / static_cast<long double>(tInputs.size());
+
+    // volatile sinks keep the timed loops from being optimized away
+    std::vector<T> tOutputs(tInputs.size());
+    volatile T tSink = 0;
+    const double tIndependent = measureBestSeconds(_repetitions, [&]()
+                                                   {
+        for (std::size_t i = 0; i < tInputs.size(); ++i)
+            tOutputs[i] = _function(tInputs[i]);
+        tSink = tOutputs[tInputs.size() / 2]; });
+    // The previous result enters the next argument multiplied by 0 (not foldable without fast-math).
+    const double tChained = measureBestSeconds(_repetitions, [&]()
+                                               {
+        T tChain = 0;
+        for (std::size_t i = 0; i < tInputs.size(); ++i)
+            tChain = _function(static_cast<T>(tInputs[i] + tChain * T(0)));
+        tSink = tChain; });
+
+    tResult.throughput = static_cast<double>(tInputs.size()) / std::max(tIndependent, std::numeric_limits<double>::min());
+    tResult.latency = tChained * 1e9 / static_cast<double>(tInputs.size());
+    return tResult;
+}
+
+// Characterizes all functors of a Complex instantiation on their typical domains.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>, class POW2 = default_pow2<T>, class SQRT = default_sqrt<T>, class ATAN = default_atan<T>>
+[[nodiscard]] std::vector<FunctorCharacterization> characterizeFunctorSet(const std::string &_prefix, std::size_t _samples = 1 << 16, std::size_t _repetitions = 5, const SIN &_sin = SIN{}, const COS &_cos = COS{}, const POW2 &_pow2 = POW2{}, const SQRT &_sqrt = SQRT{}, const ATAN &_atan = ATAN{}) noexcept(false)
+{
+    const long double tPi = std::numbers::pi_v<long double>;
+    std::vector<FunctorCharacterization> tResults;
+    tResults.push_back(characterizeFunctor<T>(_prefix + ".sin", _sin, [](long double _x) { return std::sin(_x); }, {-tPi, tPi, _samples}, _repetitions));
+    tResults.push_back(characterizeFunctor<T>(_prefix + ".cos", _cos, [](long double _x) { return std::cos(_x); }, {-tPi, tPi, _samples}, _repetitions));
+    tResults.push_back(characterizeFunctor<T>(_prefix + ".pow2", _pow2, [](long double _x) { return _x * _x; }, {-1e3L, 1e3L, _samples}, _repetitions));
+    tResults.push_back(characterizeFunctor<T>(_prefix + ".sqrt", _sqrt, [](long double _x) { return std::sqrt(_x); }, {0, 1e6L, _samples}, _repetitions));
+    tResults.push_back(characterizeFunctor<T>(_prefix + ".atan", _atan, [](long double _x) { return std::atan(_x); }, {-1e2L, 1e2L, _samples}, _repetitions));
+    return tResults;
+}
+
+// Indices of the candidates not dominated in (maxUlp, throughput), ordered by increasing maxUlp.
+// The candidates should implement the same function on the same domain.
+[[nodiscard]] inline std::vector<std::size_t> paretoFrontier(std::span<const FunctorCharacterization> _candidates) noexcept(false)
+{
+    std::vector<std::size_t> tFrontier;
+    for (std::size_t i = 0; i < _candidates.size(); ++i)
+    {
+        const bool tDominated = std::any_of(_candidates.begin(), _candidates.end(), [&](const FunctorCharacterization &_other) noexcept
+                                            { return _other.maxUlp <= _candidates[i].maxUlp && _other.throughput >= _candidates[i].throughput &&
+                                                     (_other.maxUlp < _candidates[i].maxUlp || _other.throughput > _candidates[i].throughput); });
+        if (!tDominated)
+            tFrontier.push_back(i);
+    }
+    std::sort(tFrontier.begin(), tFrontier.end(), [&](std::size_t _lh, std::size_t _rh) noexcept
+              { return _candidates[_lh].maxUlp < _candidates[_rh].maxUlp; });
+    return tFrontier;
+}
+
+// One line per candidate, with _markFrontier the Pareto optimal candidates are marked with '*'.
+inline void writeCharacterizationReport(std::ostream &_out, std::span<const FunctorCharacterization> _candidates, bool _markFrontier = true) noexcept(false)
+{
+    const auto tFrontier = _markFrontier ? paretoFrontier(_candidates) : std::vector<std::size_t>{};
+    _out << std::left << std::setw(28) << "functor" << std::right << std::setw(14) << "max ulp" << std::setw(14) << "mean ulp"
+         << std::setw(16) << "worst input" << std::setw(14) << "max abs" << std::setw(14) << "Mcalls/s" << std::setw(14) << "latency ns" << "  pareto\n";
+    for (std::size_t i = 0; i < _candidates.size(); ++i)
+    {
+        const auto &tCandidate = _candidates[i];
+        const bool tOptimal = std::find(tFrontier.begin(), tFrontier.end(), i) != tFrontier.end();
+        _out << std::left << std::setw(28) << tCandidate.name << std::right << std::setprecision(4)
+             << std::setw(14) << static_cast<double>(tCandidate.maxUlp) << std::setw(14) << static_cast<double>(tCandidate.meanUlp)
+             << std::setw(16) << static_cast<double>(tCandidate.worstInput) << std::setw(14) << static_cast<double>(tCandidate.maxAbsolute) << std::setw(14) << tCandidate.throughput * 1e-6
+             << std::setw(14) << tCandidate.latency << (tOptimal ? "  *" : "") << '\n';
+    }
+}
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cmath>
+#include <limits>
+#include <bit>
+#include <numbers>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexBatch.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Gray mapped constellations with batch hard decision and max-log soft demapping.
+// A symbol label is an integer whose bits, MSB first, are the bits of the symbol; bit arrays hold one bit (0/1) per
+// byte and LLRs are ordered the same way. LLR = (min_{s: b=1} |y - s|^2 - min_{s: b=0} |y - s|^2) / N0, positive
+// values favour 0. All constellations have unit average energy.
+//
+// Square QAM (BPSK, QPSK, 16/64/256-QAM) is separable: the first half of the bits selects the in-phase level, the
+// second half the quadrature level, each Gray coded on a PAM axis whose first bit is the sign (0: positive).
+// Per axis the min terms of the other axis cancel, so hard decisions are a rounding per axis and soft values need
+// only the squared distances to the L = sqrt(M) levels of one axis.
+// M-PSK places label gray(k) at angle 2 pi k / M. Because all points have the same energy, minimizing |y - s|^2 is
+// maximizing the correlation Re(y conj(s)), and LLR = 2 (max_{b=0} corr - max_{b=1} corr) / N0. The nearest point k
+// follows from the angle of y (sector decision). For every bit the points sharing a bit value form arcs of
+// consecutive k, so the best point with the other bit value is one of the two points bordering the arc of k:
+// each LLR needs two correlations, independent of M. Orders below kPskSectorOrder correlate with all M points.
+// Symbols are processed in tiles of kDemapTile with the tile loop innermost, so every distance, min and select is a
+// branch free loop across symbols (SIMD compares/blends); only the table lookups of the PSK neighbours run symbol by
+// symbol. Tiles are distributed over the threads.
+
+enum class Modulation
+{
+    BPSK,
+    QPSK,
+    QAM16,
+    QAM64,
+    QAM256,
+    PSK
+};
+
+constexpr std::size_t kDemapTile = 64;
+// Smallest PSK order whose soft values use the sector decision: below it, correlating with every point in
+// vectorized loops is faster than the per symbol neighbour lookups.
+constexpr std::size_t kPskSectorOrder = 32;
+// Minimum number of symbols per thread of modulate(), a symbol is only a table lookup.
+constexpr std::size_t kModulateGrain = 4096;
+
+[[nodiscard]] constexpr std::uint32_t grayEncode(std::uint32_t _value) noexcept
+{
+    return _value ^ (_value >> 1);
+}
+
+[[nodiscard]] constexpr std::uint32_t grayDecode(std::uint32_t _gray) noexcept
+{
+    for (std::uint32_t tShift = 1; tShift < 32; tShift <<= 1)
+        _gray ^= _gray >> tShift;
+    return _gray;
+}
+
+template <typename T>
+class ConstellationDemapper
+{
+private:
+    static constexpr std::size_t kMaxAxisBits = 4;
+    static constexpr std::size_t kMaxPskBits = 8;
+
+    Modulation mModulation;
+    std::size_t mThreads;
+    std::size_t mBitsPerSymbol = 0;
+    // QAM: bits and levels per axis, the Q axis is unused for BPSK.
+    std::size_t mAxisBits = 0;
+    std::size_t mAxisLevels = 0;
+    bool mHasQuadrature = true;
+    T mScale = 1;
+    // PSK: point k at angle 2 pi k / M
+    std::vector<T> mCos;
+    std::vector<T> mSin;
+    // All points indexed by label.
+    std::vector<T> mPointsRe;
+    std::vector<T> mPointsImg;
+
+    [[nodiscard]] T level(std::size_t _index) const noexcept
+    {
+        return static_cast<T>(static_cast<T>(mAxisLevels - 1) - 2 * static_cast<T>(_index)) * mScale;
+    }
+
+    // Gray label of the nearest level for every lane.
+    void decideAxis(const T *_x, std::size_t _count, std::uint32_t *_labels) const noexcept
+    {
+        const T tMax = static_cast<T>(mAxisLevels - 1);
+        for (std::size_t l = 0; l < _count; ++l)
+        {
+            // max(0, NaN) is 0, so invalid samples decide for level 0 instead of overflowing the cast. The clamped
+            // position is not negative, so a bias add and truncation round it.
+            const T tPosition = std::min(tMax, std::max(T(0), (tMax - _x[l] / mScale) / 2));
+            _labels[l] = grayEncode(static_cast<std::uint32_t>(tPosition + T(0.5)));
+        }
+    }
+
+    // Max-log LLRs of the mAxisBits bits of one axis, written to _llrs[lane * mBitsPerSymbol + _firstBit + b].
+    void softAxis(const T *_x, std::size_t _count, T _scale, T *_llrs, std::size_t _firstBit) const noexcept
+    {
+        T tMin0[kMaxAxisBits][kDemapTile];
+        T tMin1[kMaxAxisBits][kDemapTile];
+        T tDistance[kDemapTile];
+        for (std::size_t b = 0; b < mAxisBits; ++b)
+            for (std::size_t l = 0; l < _count; ++l)
+                tMin0[b][l] = tMin1[b][l] = std::numeric_limits<T>::max();
+
+        for (std::size_t tLevel = 0; tLevel < mAxisLevels; ++tLevel)
+        {
+            const T tAmplitude = level(tLevel);
+            const std::uint32_t tLabel = grayEncode(static_cast<std::uint32_t>(tLevel));
+            for (std::size_t l = 0; l < _count; ++l)
+                tDistance[l] = (_x[l] - tAmplitude) * (_x[l] - tAmplitude);
+            for (std::size_t b = 0; b < mAxisBits; ++b)
+            {
+                T *tMin = ((tLabel >> (mAxisBits - 1 - b)) & 1) ? tMin1[b] : tMin0[b];
+                for (std::size_t l = 0; l < _count; ++l)
+                    tMin[l] = std::min(tMin[l], tDistance[l]);
+            }
+        }
+        for (std::size_t l = 0; l < _count; ++l)
+            for (std::size_t b = 0; b < mAxisBits; ++b)
+                _llrs[l * mBitsPerSymbol + _firstBit + b] = (tMin1[b][l] - tMin0[b][l]) * _scale;
+    }
+
+    template <ComplexReadableView IN, class TILE>
+    void forTiles(const IN &_in, const TILE &_tile) const noexcept(false)
+    {
+        const std::size_t tTiles = (_in.size() + kDemapTile - 1) / kDemapTile;
+        complexParallelFor(tTiles, mThreads, [&](std::size_t _begin, std::size_t _end) noexcept
+                           {
+            COMPLEX_PERF_REGION("demap", std::min(_in.size(), _end * kDemapTile) - _begin * kDemapTile);
+            T tRe[kDemapTile];
+            T tImg[kDemapTile];
+            for (std::size_t tTile = _begin; tTile < _end; ++tTile)
+            {
+                const std::size_t tFirst = tTile * kDemapTile;
+                const std::size_t tCount = std::min(kDemapTile, _in.size() - tFirst);
+                for (std::size_t l = 0; l < tCount; ++l)
+                {
+                    tRe[l] = _in.real(tFirst + l);
+                    tImg[l] = _in.imag(tFirst + l);
+                }
+                _tile(tFirst, tCount, tRe, tImg);
+            } });
+    }
+
+    // PSK: index k of the nearest point for every lane, from the sector of the angle of the sample.
+    void decideSector(const T *_re, const T *_img, std::size_t _count, std::uint32_t *_index) const noexcept
+    {
+        const T tPerRadian = static_cast<T>(mCos.size()) / (2 * std::numbers::pi_v<T>);
+        const auto tMask = static_cast<std::uint32_t>(mCos.size() - 1);
+        for (std::size_t l = 0; l < _count; ++l)
+        {
+            // In [-M/2, M/2], rounded by a bias add and truncation; invalid samples decide for point 0 instead of
+            // overflowing the cast.
+            const T tSector = poly_atan2<T>{}(_img[l], _re[l]) * tPerRadian;
+            const T tRounded = tSector + std::copysign(T(0.5), tSector);
+            _index[l] = static_cast<std::uint32_t>(static_cast<std::int32_t>(std::isnan(tRounded) ? T(0) : tRounded)) & tMask;
+        }
+    }
+
+    // PSK correlations Re(y conj(s_k)) for all lanes of a tile.
+    void correlate(const T *_re, const T *_img, std::size_t _count, std::size_t _point, T *_correlation) const noexcept
+    {
+        const T tCos = mCos[_point];
+        const T tSin = mSin[_point];
+        for (std::size_t l = 0; l < _count; ++l)
+            _correlation[l] = _re[l] * tCos + _img[l] * tSin;
+    }
+
+    // PSK correlation Re(y conj(s_k)) of one sample.
+    [[nodiscard]] T correlate(T _re, T _img, std::uint32_t _point) const noexcept
+    {
+        return _re * mCos[_point] + _img * mSin[_point];
+    }
+
+    void decideTile(const T *_re, const T *_img, std::size_t _count, std::uint32_t *_labels) const noexcept
+    {
+        if (mModulation != Modulation::PSK)
+        {
+            std::uint32_t tQ[kDemapTile] = {};
+            decideAxis(_re, _count, _labels);
+            if (mHasQuadrature)
+            {
+                decideAxis(_img, _count, tQ);
+                for (std::size_t l = 0; l < _count; ++l)
+                    _labels[l] = (_labels[l] << mAxisBits) | tQ[l];
+            }
+            return;
+        }
+
+        decideSector(_re, _img, _count, _labels);
+        for (std::size_t l = 0; l < _count; ++l)
+            _labels[l] = grayEncode(_labels[l]);
+    }
+
+public:
+    // _pskOrder is the number of points for Modulation::PSK (a power of 2 from 2 to 256) and ignored otherwise.
+    explicit ConstellationDemapper(Modulation _modulation, std::size_t _pskOrder = 8, std::size_t _threads = 0) noexcept(false)
+        : mModulation(_modulation), mThreads(complexThreadCount(_threads))
+    {
+        switch (_modulation)
+        {
+        case Modulation::BPSK:
+            mAxisBits = 1;
+            mHasQuadrature = false;
+            break;
+        case Modulation::QPSK:
+            mAxisBits = 1;
+            break;
+        case Modulation::QAM16:
+            mAxisBits = 2;
+            break;
+        case Modulation::QAM64:
+            mAxisBits = 3;
+            break;
+        case Modulation::QAM256:
+            mAxisBits = 4;
+            break;
+        case Modulation::PSK:
+            if (_pskOrder < 2 || _pskOrder > (std::size_t{1} << kMaxPskBits) || (_pskOrder & (_pskOrder - 1)) != 0)
+                throw std::invalid_argument("ConstellationDemapper: PSK order must be a power of 2 in [2, 256]");
+            break;
+        }
+
+        if (_modulation == Modulation::PSK)
+        {
+            mBitsPerSymbol = static_cast<std::size_t>(std::countr_zero(_pskOrder));
+            mCos.resize(_pskOrder);
+            mSin.resize(_pskOrder);
+            mPointsRe.resize(_pskOrder);
+            mPointsImg.resize(_pskOrder);
+            for (std::size_t k = 0; k < _pskOrder; ++k)
+            {
+                const T tAngle = static_cast<T>(2 * std::numbers::pi_v<T> * static_cast<T>(k) / static_cast<T>(_pskOrder));
+                mCos[k] = std::cos(tAngle);
+                mSin[k] = std::sin(tAngle);
+                mPointsRe[grayEncode(static_cast<std::uint32_t>(k))] = mCos[k];
+                mPointsImg[grayEncode(static_cast<std::uint32_t>(k))] = mSin[k];
+            }
+            return;
+        }
+
+        mAxisLevels = std::size_t{1} << mAxisBits;
+        const T tLevelEnergy = static_cast<T>(mAxisLevels * mAxisLevels - 1) / 3;
+        mScale = T(1) / std::sqrt(mHasQuadrature ? 2 * tLevelEnergy : tLevelEnergy);
+        mBitsPerSymbol = mHasQuadrature ? 2 * mAxisBits : mAxisBits;
+        const std::size_t tQLevels = mHasQuadrature ? mAxisLevels : 1;
+        mPointsRe.resize(mAxisLevels * tQLevels);
+        mPointsImg.resize(mAxisLevels * tQLevels);
+        for (std::size_t i = 0; i < mAxisLevels; ++i)
+            for (std::size_t q = 0; q < tQLevels; ++q)
+            {
+                const std::uint32_t tLabel = mHasQuadrature ? (grayEncode(static_cast<std::uint32_t>(i)) << mAxisBits) | grayEncode(static_cast<std::uint32_t>(q)) : grayEncode(static_cast<std::uint32_t>(i));
+                mPointsRe[tLabel] = level(i);
+                mPointsImg[tLabel] = mHasQuadrature ? level(q) : T(0);
+            }
+    }
+
+    [[nodiscard]] Modulation getModulation() const noexcept { return mModulation; }
+    [[nodiscard]] std::size_t getBitsPerSymbol() const noexcept { return mBitsPerSymbol; }
+    [[nodiscard]] std::size_t getOrder() const noexcept { return mPointsRe.size(); }
+    // Constellation points indexed by label.
+    [[nodiscard]] ComplexSplitSpan<const T> getPoints() const noexcept { return ComplexSplitSpan<const T>(mPointsRe.data(), mPointsImg.data(), mPointsRe.size()); }
+
+    // Maps getBitsPerSymbol() bits per symbol to constellation points.
+    template <ComplexWritableView OUT>
+    void modulate(std::span<const std::uint8_t> _bits, const OUT &_out) const noexcept(false)
+    {
+        if (_bits.size() != _out.size() * mBitsPerSymbol)
+            throw std::invalid_argument("ConstellationDemapper::modulate: bit count does not match the number of symbols");
+        complexParallelFor(_out.size(), mThreads, [&](std::size_t _begin, std::size_t _end) noexcept
+                           {
+            for (std::size_t s = _begin; s < _end; ++s)
+            {
+                std::uint32_t tLabel = 0;
+                for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                    tLabel = (tLabel << 1) | (_bits[s * mBitsPerSymbol + b] & 1u);
+                _out.set(s, mPointsRe[tLabel], mPointsImg[tLabel]);
+            } }, kModulateGrain);
+    }
+
+    // Label of the nearest constellation point for every symbol.
+    template <ComplexReadableView IN>
+    void demapSymbols(const IN &_in, std::span<std::uint32_t> _labels) const noexcept(false)
+    {
+        if (_labels.size() != _in.size())
+            throw std::invalid_argument("ConstellationDemapper::demapSymbols: output size does not match the number of symbols");
+        forTiles(_in, [&](std::size_t _first, std::size_t _count, const T *_re, const T *_img) noexcept
+                 { decideTile(_re, _img, _count, _labels.data() + _first); });
+    }
+
+    // Hard decisions, getBitsPerSymbol() bits per symbol.
+    template <ComplexReadableView IN>
+    void demapHard(const IN &_in, std::span<std::uint8_t> _bits) const noexcept(false)
+    {
+        if (_bits.size() != _in.size() * mBitsPerSymbol)
+            throw std::invalid_argument("ConstellationDemapper::demapHard: output size does not match the number of bits");
+        forTiles(_in, [&](std::size_t _first, std::size_t _count, const T *_re, const T *_img) noexcept
+                 {
+            std::uint32_t tLabels[kDemapTile];
+            decideTile(_re, _img, _count, tLabels);
+            for (std::size_t l = 0; l < _count; ++l)
+                for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                    _bits[(_first + l) * mBitsPerSymbol + b] = static_cast<std::uint8_t>((tLabels[l] >> (mBitsPerSymbol - 1 - b)) & 1u); });
+    }
+
+    // Max-log LLRs for complex Gaussian noise of variance _noiseVariance (N0), getBitsPerSymbol() values per symbol.
+    template <ComplexReadableView IN>
+    void demapSoft(const IN &_in, T _noiseVariance, std::span<T> _llrs) const noexcept(false)
+    {
+        if (_llrs.size() != _in.size() * mBitsPerSymbol)
+            throw std::invalid_argument("ConstellationDemapper::demapSoft: output size does not match the number of bits");
+        if (!(_noiseVariance > 0))
+            throw std::invalid_argument("ConstellationDemapper::demapSoft: noise variance must be positive");
+        const T tScale = T(1) / _noiseVariance;
+
+        if (mModulation != Modulation::PSK)
+        {
+            forTiles(_in, [&](std::size_t _first, std::size_t _count, const T *_re, const T *_img) noexcept
+                     {
+                T *tLlrs = _llrs.data() + _first * mBitsPerSymbol;
+                softAxis(_re, _count, tScale, tLlrs, 0);
+                if (mHasQuadrature)
+                    softAxis(_img, _count, tScale, tLlrs, mAxisBits); });
+            return;
+        }
+
+        if (mCos.size() < kPskSectorOrder)
+        {
+            forTiles(_in, [&](std::size_t _first, std::size_t _count, const T *_re, const T *_img) noexcept
+                     {
+                T tMax0[kMaxPskBits][kDemapTile];
+                T tMax1[kMaxPskBits][kDemapTile];
+                T tCorrelation[kDemapTile];
+                for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                    for (std::size_t l = 0; l < _count; ++l)
+                        tMax0[b][l] = tMax1[b][l] = std::numeric_limits<T>::lowest();
+                for (std::size_t k = 0; k < mCos.size(); ++k)
+                {
+                    correlate(_re, _img, _count, k, tCorrelation);
+                    const std::uint32_t tLabel = grayEncode(static_cast<std::uint32_t>(k));
+                    for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                    {
+                        T *tMax = ((tLabel >> (mBitsPerSymbol - 1 - b)) & 1) ? tMax1[b] : tMax0[b];
+                        for (std::size_t l = 0; l < _count; ++l)
+                            tMax[l] = std::max(tMax[l], tCorrelation[l]);
+                    }
+                }
+                for (std::size_t l = 0; l < _count; ++l)
+                    for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                        _llrs[(_first + l) * mBitsPerSymbol + b] = 2 * (tMax0[b][l] - tMax1[b][l]) * tScale; });
+            return;
+        }
+
+        forTiles(_in, [&](std::size_t _first, std::size_t _count, const T *_re, const T *_img) noexcept
+                 {
+            const auto tMask = static_cast<std::uint32_t>(mCos.size() - 1);
+            std::uint32_t tIndex[kDemapTile];
+            decideSector(_re, _img, _count, tIndex);
+            for (std::size_t l = 0; l < _count; ++l)
+            {
+                const std::uint32_t tNearest = tIndex[l];
+                const std::uint32_t tLabel = grayEncode(tNearest);
+                const T tCorrelation = correlate(_re[l], _img[l], tNearest);
+                T *tLlrs = _llrs.data() + (_first + l) * mBitsPerSymbol;
+                for (std::size_t b = 0; b < mBitsPerSymbol; ++b)
+                {
+                    // Bit b of gray(k) is constant on arcs of tRun consecutive k starting at tOffset (mod tRun); the
+                    // MSB splits the circle into the halves [0, M/2) and [M/2, M).
+                    const std::size_t tBit = mBitsPerSymbol - 1 - b;
+                    const std::uint32_t tRun = b == 0 ? tMask / 2 + 1 : 2u << tBit;
+                    const std::uint32_t tOffset = b == 0 ? 0 : 1u << tBit;
+                    const std::uint32_t tStart = ((tNearest + tOffset) & ~(tRun - 1)) - tOffset;
+                    const T tOther = std::max(correlate(_re[l], _img[l], (tStart - 1) & tMask), correlate(_re[l], _img[l], (tStart + tRun) & tMask));
+                    // +2 / N0 if the nearest point has a 0 at bit b, -2 / N0 otherwise.
+                    const T tSign = static_cast<T>(1 - 2 * static_cast<int>((tLabel >> tBit) & 1));
+                    tLlrs[b] = 2 * tSign * (tCorrelation - tOther) * tScale;
+                }
+            } });
+    }
+};
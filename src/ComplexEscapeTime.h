@@ -0,0 +1,147 @@
+#pragma once
+
+#include <span>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Escape-time iteration z = z^2 + c for many independent points.
+// kEscapeTimeLanes points are advanced together on plain re/im arrays: every step is a branch free loop over the lanes
+// (the compiler maps it onto SIMD registers with per-lane blend masks), the escape test compares the squared
+// magnitude against bailout^2 instead of computing sqrt/atan, and a group leaves the loop as soon as all its lanes escaped.
+// Tiles of points are handed out to the threads dynamically because the iteration depth varies strongly between regions.
+
+constexpr std::size_t kEscapeTimeLanes = 8;
+
+template <typename T>
+struct EscapeTimeOptions
+{
+    std::uint32_t maxIterations = 256;
+    T bailout = 2;
+    // 0: one thread per hardware thread
+    std::size_t threads = 0;
+    // Number of points per scheduled tile, rounded up to a multiple of kEscapeTimeLanes.
+    std::size_t tileSize = 1024;
+};
+
+// Runs the recurrence for the points [_first, _first + _count) with _count <= kEscapeTimeLanes.
+// _load(index, zRe, zImg, cRe, cImg) provides start value and constant per point.
+// _iterations receives the number of steps before |z| exceeded the bailout, or maxIterations if it never did.
+template <typename T, class LOAD>
+void escapeTimeLanes(std::size_t _first, std::size_t _count, const LOAD &_load, std::uint32_t *_iterations, std::uint32_t _maxIterations, T _bailout2) noexcept
+{
+    T tZRe[kEscapeTimeLanes] = {};
+    T tZImg[kEscapeTimeLanes] = {};
+    T tCRe[kEscapeTimeLanes] = {};
+    T tCImg[kEscapeTimeLanes] = {};
+    std::uint32_t tCount[kEscapeTimeLanes] = {};
+    // Unused lanes start escaped.
+    T tActive[kEscapeTimeLanes] = {};
+
+    for (std::size_t l = 0; l < _count; ++l)
+    {
+        _load(_first + l, tZRe[l], tZImg[l], tCRe[l], tCImg[l]);
+        tActive[l] = 1;
+    }
+
+    for (std::uint32_t tStep = 0; tStep < _maxIterations; ++tStep)
+    {
+        T tAny = 0;
+        for (std::size_t l = 0; l < kEscapeTimeLanes; ++l)
+        {
+            const T tRe2 = tZRe[l] * tZRe[l];
+            const T tImg2 = tZImg[l] * tZImg[l];
+            const T tInside = (tRe2 + tImg2 <= _bailout2) ? tActive[l] : T(0);
+            tCount[l] += static_cast<std::uint32_t>(tInside);
+            const T tNextRe = tRe2 - tImg2 + tCRe[l];
+            const T tNextImg = 2 * tZRe[l] * tZImg[l] + tCImg[l];
+            tZRe[l] = tInside != 0 ? tNextRe : tZRe[l];
+            tZImg[l] = tInside != 0 ? tNextImg : tZImg[l];
+            tActive[l] = tInside;
+            tAny += tInside;
+        }
+        if (tAny == 0)
+            break;
+    }
+
+    for (std::size_t l = 0; l < _count; ++l)
+        _iterations[_first + l] = tCount[l];
+}
+
+template <typename T, class LOAD>
+void escapeTimeTiled(std::size_t _size, const LOAD &_load, std::span<std::uint32_t> _iterations, const EscapeTimeOptions<T> &_options) noexcept(false)
+{
+    if (_iterations.size() != _size)
+        throw std::invalid_argument("escapeTime: output size does not match the number of points");
+
+    const std::size_t tTileSize = std::max<std::size_t>(1, (_options.tileSize + kEscapeTimeLanes - 1) / kEscapeTimeLanes) * kEscapeTimeLanes;
+    const std::size_t tTiles = (_size + tTileSize - 1) / tTileSize;
+    const T tBailout2 = _options.bailout * _options.bailout;
+    const std::size_t tThreads = std::min(complexThreadCount(_options.threads), tTiles);
+
+    std::atomic<std::size_t> tNextTile{0};
+    complexParallelFor(tThreads, tThreads, [&](std::size_t, std::size_t) noexcept
+                       {
+        for (std::size_t tTile = tNextTile++; tTile < tTiles; tTile = tNextTile++)
+        {
+            const std::size_t tEnd = std::min(_size, (tTile + 1) * tTileSize);
+            COMPLEX_PERF_REGION("escapeTime", tEnd - tTile * tTileSize);
+            for (std::size_t tFirst = tTile * tTileSize; tFirst < tEnd; tFirst += kEscapeTimeLanes)
+                escapeTimeLanes<T>(tFirst, std::min(kEscapeTimeLanes, tEnd - tFirst), _load, _iterations.data(), _options.maxIterations, tBailout2);
+        } });
+}
+
+// Mandelbrot type iteration: z starts at 0, c is taken from _points.
+template <ComplexReadableView IN>
+void escapeTime(const IN &_points, std::span<std::uint32_t> _iterations, const EscapeTimeOptions<typename IN::value_type> &_options = {}) noexcept(false)
+{
+    using T = typename IN::value_type;
+    escapeTimeTiled<T>(_points.size(), [&_points](std::size_t _index, T &_zRe, T &_zImg, T &_cRe, T &_cImg) noexcept
+                       {
+        _zRe = 0;
+        _zImg = 0;
+        _cRe = _points.real(_index);
+        _cImg = _points.imag(_index); },
+                       _iterations, _options);
+}
+
+// Julia type iteration: z starts at _points, c is the same for all points.
+template <ComplexReadableView IN, class SIN, class COS, class POW2, class SQRT, class ATAN>
+void escapeTime(const IN &_points, const Complex<typename IN::value_type, SIN, COS, POW2, SQRT, ATAN> &_c, std::span<std::uint32_t> _iterations, const EscapeTimeOptions<typename IN::value_type> &_options = {}) noexcept(false)
+{
+    using T = typename IN::value_type;
+    const T tCRe = _c.getReal();
+    const T tCImg = _c.getImaginary();
+    escapeTimeTiled<T>(_points.size(), [&_points, tCRe, tCImg](std::size_t _index, T &_zRe, T &_zImg, T &_cRe, T &_cImg) noexcept
+                       {
+        _zRe = _points.real(_index);
+        _zImg = _points.imag(_index);
+        _cRe = tCRe;
+        _cImg = tCImg; },
+                       _iterations, _options);
+}
+
+// Mandelbrot iteration over a regular _width x _height grid (row-major output) starting at _origin with the
+// given pixel spacing; the points are generated on the fly instead of being materialized.
+template <typename T, class SIN, class COS, class POW2, class SQRT, class ATAN>
+void escapeTimeGrid(const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_origin, T _step, std::size_t _width, std::size_t _height, std::span<std::uint32_t> _iterations, const EscapeTimeOptions<T> &_options = {}) noexcept(false)
+{
+    if (_width == 0)
+        throw std::invalid_argument("escapeTimeGrid: width must not be 0");
+    const T tOriginRe = _origin.getReal();
+    const T tOriginImg = _origin.getImaginary();
+    escapeTimeTiled<T>(_width * _height, [=](std::size_t _index, T &_zRe, T &_zImg, T &_cRe, T &_cImg) noexcept
+                       {
+        _zRe = 0;
+        _zImg = 0;
+        _cRe = tOriginRe + _step * static_cast<T>(_index % _width);
+        _cImg = tOriginImg + _step * static_cast<T>(_index / _width); },
+                       _iterations, _options);
+}
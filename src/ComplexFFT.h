@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <memory_resource>
+#include <numbers>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+
+enum class FFTDirection
+{
+    Forward,
+    Inverse
+};
+
+[[nodiscard]] constexpr bool isPowerOf2(std::size_t _value) noexcept
+{
+    return _value != 0 && (_value & (_value - 1)) == 0;
+}
+
+// Radix-2 in-place FFT of a fixed power of 2 size on split planes.
+// The forward transform is unnormalized, the inverse transform is scaled by 1/N so that inverse(forward(x)) == x.
+// Twiddles are stored contiguously per butterfly stage so the inner loops run over consecutive memory.
+// transform() on raw planes is const and uses no scratch memory, so one plan can be shared by many threads.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+class FFTPlan
+{
+private:
+    std::size_t mSize = 0;
+    std::pmr::vector<std::pair<std::size_t, std::size_t>> mSwaps;
+    // Stage with butterfly half size h uses the twiddles [h - 1, 2h - 1).
+    std::pmr::vector<T> mTwiddleCos;
+    std::pmr::vector<T> mTwiddleSin;
+    SIN mSin;
+    COS mCos;
+
+public:
+    explicit FFTPlan(std::size_t _size, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mSize(_size), mSwaps(_resource), mTwiddleCos(_size > 1 ? _size - 1 : 0, _resource), mTwiddleSin(_size > 1 ? _size - 1 : 0, _resource)
+    {
+        if (!isPowerOf2(_size))
+            throw std::invalid_argument("FFTPlan: size must be a power of 2");
+
+        for (std::size_t i = 1, j = 0; i < _size; ++i)
+        {
+            std::size_t tBit = _size >> 1;
+            for (; j & tBit; tBit >>= 1)
+                j ^= tBit;
+            j ^= tBit;
+            if (i < j)
+                mSwaps.emplace_back(i, j);
+        }
+
+        for (std::size_t tHalf = 1; tHalf < _size; tHalf <<= 1)
+        {
+            for (std::size_t k = 0; k < tHalf; ++k)
+            {
+                const T tAngle = static_cast<T>(std::numbers::pi_v<T> * static_cast<T>(k) / static_cast<T>(tHalf));
+                mTwiddleCos[tHalf - 1 + k] = mCos(tAngle);
+                mTwiddleSin[tHalf - 1 + k] = mSin(tAngle);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t getSize() const noexcept { return mSize; }
+
+    void transform(T *_re, T *_img, FFTDirection _direction) const noexcept
+    {
+        for (const auto &[tFirst, tSecond] : mSwaps)
+        {
+            std::swap(_re[tFirst], _re[tSecond]);
+            std::swap(_img[tFirst], _img[tSecond]);
+        }
+
+        const T tSign = _direction == FFTDirection::Forward ? T(-1) : T(1);
+        for (std::size_t tHalf = 1; tHalf < mSize; tHalf <<= 1)
+        {
+            const T *tCos = mTwiddleCos.data() + tHalf - 1;
+            const T *tSin = mTwiddleSin.data() + tHalf - 1;
+            for (std::size_t tStart = 0; tStart < mSize; tStart += 2 * tHalf)
+            {
+                T *tRe0 = _re + tStart;
+                T *tImg0 = _img + tStart;
+                T *tRe1 = tRe0 + tHalf;
+                T *tImg1 = tImg0 + tHalf;
+                for (std::size_t k = 0; k < tHalf; ++k)
+                {
+                    const T tWSin = tSign * tSin[k];
+                    const T tRe = tRe1[k] * tCos[k] - tImg1[k] * tWSin;
+                    const T tImg = tRe1[k] * tWSin + tImg1[k] * tCos[k];
+                    tRe1[k] = tRe0[k] - tRe;
+                    tImg1[k] = tImg0[k] - tImg;
+                    tRe0[k] += tRe;
+                    tImg0[k] += tImg;
+                }
+            }
+        }
+
+        if (_direction == FFTDirection::Inverse)
+        {
+            const T tScale = T(1) / static_cast<T>(mSize);
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                _re[i] *= tScale;
+                _img[i] *= tScale;
+            }
+        }
+    }
+
+    void transform(const ComplexSplitSpan<T> &_data, FFTDirection _direction) const noexcept(false)
+    {
+        if (_data.size() != mSize)
+            throw std::invalid_argument("FFTPlan: view size does not match the plan");
+        transform(_data.realData(), _data.imagData(), _direction);
+    }
+
+    // Other layouts are transformed through temporary split planes.
+    template <ComplexWritableView V>
+    void transform(const V &_data, FFTDirection _direction) const noexcept(false)
+    {
+        if (_data.size() != mSize)
+            throw std::invalid_argument("FFTPlan: view size does not match the plan");
+        std::vector<T> tRe(mSize);
+        std::vector<T> tImg(mSize);
+        for (std::size_t i = 0; i < mSize; ++i)
+        {
+            tRe[i] = _data.real(i);
+            tImg[i] = _data.imag(i);
+        }
+        transform(tRe.data(), tImg.data(), _direction);
+        for (std::size_t i = 0; i < mSize; ++i)
+            _data.set(i, tRe[i], tImg[i]);
+    }
+};
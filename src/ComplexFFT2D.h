@@ -0,0 +1,274 @@
+#pragma once
+
+#include <vector>
+#include <memory_resource>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+#include "ComplexFFT.h"
+#include "ComplexParallel.h"
+#include "ComplexView.h"
+#include "ComplexPerfRegion.h"
+
+// Multidimensional FFTs on row-major split planes.
+// Column passes are never run with a stride: FFT2DPlan transposes the grid with a cache-oblivious
+// blocked transpose so that every 1D transform runs on contiguous memory, fftND() gathers bundles of
+// neighbouring lines into a small contiguous buffer instead.
+
+// Transposes the rows [_rowBegin, _rowEnd) x columns [_colBegin, _colEnd) of the _rows x _cols matrix _src into the _cols x _rows matrix _dst.
+// The range is split along its larger side until a tile fits into the L1 cache, which is efficient for every cache size without tuning.
+template <typename T>
+void transposeBlocked(const T *_src, T *_dst, std::size_t _rows, std::size_t _cols, std::size_t _rowBegin, std::size_t _rowEnd, std::size_t _colBegin, std::size_t _colEnd) noexcept
+{
+    constexpr std::size_t kTile = 32;
+    const std::size_t tRowCount = _rowEnd - _rowBegin;
+    const std::size_t tColCount = _colEnd - _colBegin;
+    if (tRowCount <= kTile && tColCount <= kTile)
+    {
+        for (std::size_t r = _rowBegin; r < _rowEnd; ++r)
+            for (std::size_t c = _colBegin; c < _colEnd; ++c)
+                _dst[c * _rows + r] = _src[r * _cols + c];
+    }
+    else if (tRowCount >= tColCount)
+    {
+        const std::size_t tMiddle = _rowBegin + tRowCount / 2;
+        transposeBlocked(_src, _dst, _rows, _cols, _rowBegin, tMiddle, _colBegin, _colEnd);
+        transposeBlocked(_src, _dst, _rows, _cols, tMiddle, _rowEnd, _colBegin, _colEnd);
+    }
+    else
+    {
+        const std::size_t tMiddle = _colBegin + tColCount / 2;
+        transposeBlocked(_src, _dst, _rows, _cols, _rowBegin, _rowEnd, _colBegin, tMiddle);
+        transposeBlocked(_src, _dst, _rows, _cols, _rowBegin, _rowEnd, tMiddle, _colEnd);
+    }
+}
+
+template <typename T>
+void transposeBlocked(const ComplexSplitSpan<const T> &_src, const ComplexSplitSpan<T> &_dst, std::size_t _rows, std::size_t _cols, std::size_t _threads = 0) noexcept(false)
+{
+    complexParallelFor(_rows, _threads, [&](std::size_t _begin, std::size_t _end) noexcept
+                       {
+        transposeBlocked(_src.realData(), _dst.realData(), _rows, _cols, _begin, _end, std::size_t{0}, _cols);
+        transposeBlocked(_src.imagData(), _dst.imagData(), _rows, _cols, _begin, _end, std::size_t{0}, _cols); });
+}
+
+// 2D FFT of a _rows x _cols grid, both sizes have to be powers of 2.
+// The plan owns scratch memory, so one plan must not be used by several threads at the same time;
+// the transform itself runs its row and column passes on _threads threads (0: all hardware threads).
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+class FFT2DPlan
+{
+private:
+    std::size_t mRows = 0;
+    std::size_t mCols = 0;
+    std::size_t mThreads = 0;
+    FFTPlan<T, SIN, COS> mRowPlan;
+    FFTPlan<T, SIN, COS> mColPlan;
+    std::pmr::vector<T> mScratchRe;
+    std::pmr::vector<T> mScratchImg;
+    std::pmr::vector<T> mHalfRe;
+    std::pmr::vector<T> mHalfImg;
+
+    void rowPass(T *_re, T *_img, std::size_t _rows, std::size_t _length, const FFTPlan<T, SIN, COS> &_plan, FFTDirection _direction) const noexcept(false)
+    {
+        complexParallelFor(_rows, mThreads, [&](std::size_t _begin, std::size_t _end) noexcept
+                           {
+            COMPLEX_PERF_REGION("fft2dRows", (_end - _begin) * _length);
+            for (std::size_t r = _begin; r < _end; ++r)
+                _plan.transform(_re + r * _length, _img + r * _length, _direction); });
+    }
+
+    // Transforms the columns of the _rows x _width grid in _data in place, using the scratch planes.
+    void columnPass(const ComplexSplitSpan<T> &_data, std::size_t _width, FFTDirection _direction) noexcept(false)
+    {
+        const ComplexSplitSpan<T> tScratch(mScratchRe.data(), mScratchImg.data(), mRows * _width);
+        transposeBlocked<T>(_data, tScratch, mRows, _width, mThreads);
+        rowPass(tScratch.realData(), tScratch.imagData(), _width, mRows, mColPlan, _direction);
+        transposeBlocked<T>(tScratch, _data, _width, mRows, mThreads);
+    }
+
+public:
+    FFT2DPlan(std::size_t _rows, std::size_t _cols, std::size_t _threads = 0, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mRows(_rows), mCols(_cols), mThreads(complexThreadCount(_threads)), mRowPlan(_cols, _resource), mColPlan(_rows, _resource),
+          mScratchRe(_resource), mScratchImg(_resource), mHalfRe(_resource), mHalfImg(_resource)
+    {
+    }
+
+    [[nodiscard]] std::size_t getRows() const noexcept { return mRows; }
+    [[nodiscard]] std::size_t getCols() const noexcept { return mCols; }
+    // Number of columns of the half spectrum produced by the real transforms.
+    [[nodiscard]] std::size_t getHalfCols() const noexcept { return mCols / 2 + 1; }
+
+    void transform(const ComplexSplitSpan<T> &_data, FFTDirection _direction) noexcept(false)
+    {
+        if (_data.size() != mRows * mCols)
+            throw std::invalid_argument("FFT2DPlan: view size does not match the plan");
+        mScratchRe.resize(mRows * mCols);
+        mScratchImg.resize(mRows * mCols);
+
+        rowPass(_data.realData(), _data.imagData(), mRows, mCols, mRowPlan, _direction);
+        columnPass(_data, mCols, _direction);
+    }
+
+    // Real-to-complex forward transform. _out receives the non redundant half spectrum of
+    // _rows x getHalfCols() values, the rest follows from Hermitian symmetry X(r, c) = conj(X(-r, -c)).
+    // Two real rows are packed into one complex row, so the row pass needs only half of the 1D transforms.
+    void transformReal(std::span<const T> _in, const ComplexSplitSpan<T> &_out) noexcept(false)
+    {
+        const std::size_t tHalfCols = getHalfCols();
+        if (_in.size() != mRows * mCols || _out.size() != mRows * tHalfCols)
+            throw std::invalid_argument("FFT2DPlan: buffer sizes do not match the plan");
+        mScratchRe.resize(mRows * tHalfCols);
+        mScratchImg.resize(mRows * tHalfCols);
+
+        complexParallelFor((mRows + 1) / 2, mThreads, [&](std::size_t _begin, std::size_t _end)
+                           {
+            COMPLEX_PERF_REGION("fft2dRows", std::min(mRows, 2 * _end) * mCols - 2 * _begin * mCols);
+            std::vector<T> tRe(mCols);
+            std::vector<T> tImg(mCols);
+            for (std::size_t p = _begin; p < _end; ++p)
+            {
+                const std::size_t tRow0 = 2 * p;
+                const std::size_t tRow1 = tRow0 + 1;
+                std::copy_n(_in.data() + tRow0 * mCols, mCols, tRe.begin());
+                if (tRow1 < mRows)
+                    std::copy_n(_in.data() + tRow1 * mCols, mCols, tImg.begin());
+                else
+                    std::fill(tImg.begin(), tImg.end(), T{0});
+                mRowPlan.transform(tRe.data(), tImg.data(), FFTDirection::Forward);
+
+                for (std::size_t k = 0; k < tHalfCols; ++k)
+                {
+                    const std::size_t tMirror = (mCols - k) & (mCols - 1);
+                    // A = (Z[k] + conj(Z[-k])) / 2, B = (Z[k] - conj(Z[-k])) / 2j
+                    _out.set(tRow0 * tHalfCols + k, (tRe[k] + tRe[tMirror]) / 2, (tImg[k] - tImg[tMirror]) / 2);
+                    if (tRow1 < mRows)
+                        _out.set(tRow1 * tHalfCols + k, (tImg[k] + tImg[tMirror]) / 2, (tRe[tMirror] - tRe[k]) / 2);
+                }
+            } });
+
+        columnPass(_out, tHalfCols, FFTDirection::Forward);
+    }
+
+    // Complex-to-real inverse transform of a half spectrum as produced by transformReal(), scaled by 1/(rows * cols).
+    void inverseTransformReal(const ComplexSplitSpan<const T> &_in, std::span<T> _out) noexcept(false)
+    {
+        const std::size_t tHalfCols = getHalfCols();
+        if (_out.size() != mRows * mCols || _in.size() != mRows * tHalfCols)
+            throw std::invalid_argument("FFT2DPlan: buffer sizes do not match the plan");
+        mScratchRe.resize(mRows * tHalfCols);
+        mScratchImg.resize(mRows * tHalfCols);
+        mHalfRe.resize(mRows * tHalfCols);
+        mHalfImg.resize(mRows * tHalfCols);
+
+        const ComplexSplitSpan<T> tHalf(mHalfRe.data(), mHalfImg.data(), mRows * tHalfCols);
+        std::copy_n(_in.realData(), tHalf.size(), mHalfRe.begin());
+        std::copy_n(_in.imagData(), tHalf.size(), mHalfImg.begin());
+        columnPass(tHalf, tHalfCols, FFTDirection::Inverse);
+
+        complexParallelFor((mRows + 1) / 2, mThreads, [&](std::size_t _begin, std::size_t _end)
+                           {
+            COMPLEX_PERF_REGION("fft2dRows", std::min(mRows, 2 * _end) * mCols - 2 * _begin * mCols);
+            std::vector<T> tRe(mCols);
+            std::vector<T> tImg(mCols);
+            for (std::size_t p = _begin; p < _end; ++p)
+            {
+                const std::size_t tRow0 = 2 * p;
+                const std::size_t tRow1 = tRow0 + 1;
+                const T *tARe = mHalfRe.data() + tRow0 * tHalfCols;
+                const T *tAImg = mHalfImg.data() + tRow0 * tHalfCols;
+                for (std::size_t k = 0; k < mCols; ++k)
+                {
+                    // Z = A + jB, the upper half is rebuilt from the mirrored conjugates.
+                    const bool tMirrored = k >= tHalfCols;
+                    const std::size_t tIndex = tMirrored ? mCols - k : k;
+                    const T tSign = tMirrored ? T(-1) : T(1);
+                    T tBRe = 0;
+                    T tBImg = 0;
+                    if (tRow1 < mRows)
+                    {
+                        tBRe = mHalfRe[tRow1 * tHalfCols + tIndex];
+                        tBImg = tSign * mHalfImg[tRow1 * tHalfCols + tIndex];
+                    }
+                    tRe[k] = tARe[tIndex] - tBImg;
+                    tImg[k] = tSign * tAImg[tIndex] + tBRe;
+                }
+                mRowPlan.transform(tRe.data(), tImg.data(), FFTDirection::Inverse);
+                std::copy_n(tRe.begin(), mCols, _out.data() + tRow0 * mCols);
+                if (tRow1 < mRows)
+                    std::copy_n(tImg.begin(), mCols, _out.data() + tRow1 * mCols);
+            } });
+    }
+};
+
+// N-dimensional FFT of a row-major grid with the given _shape (every extent a power of 2), in place.
+// Lines along an axis that is not the innermost are processed in bundles of neighbouring lines: the bundle is
+// gathered into a contiguous buffer, transformed and scattered back, which keeps memory accesses sequential.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+void fftND(const ComplexSplitSpan<T> &_data, std::span<const std::size_t> _shape, FFTDirection _direction, std::size_t _threads = 0) noexcept(false)
+{
+    constexpr std::size_t kBundle = 16;
+
+    std::size_t tTotal = 1;
+    for (const auto tExtent : _shape)
+    {
+        if (tExtent == 0)
+            throw std::invalid_argument("fftND: extents must not be 0");
+        tTotal *= tExtent;
+    }
+    if (_shape.empty() || tTotal != _data.size())
+        throw std::invalid_argument("fftND: shape does not match the view size");
+
+    std::size_t tOuter = 1;
+    for (std::size_t tAxis = 0; tAxis < _shape.size(); ++tAxis)
+    {
+        const std::size_t tLength = _shape[tAxis];
+        const std::size_t tInner = tTotal / (tOuter * tLength);
+        const FFTPlan<T, SIN, COS> tPlan(tLength);
+
+        if (tInner == 1)
+        {
+            complexParallelFor(tOuter, _threads, [&](std::size_t _begin, std::size_t _end) noexcept
+                               {
+                for (std::size_t o = _begin; o < _end; ++o)
+                    tPlan.transform(_data.realData() + o * tLength, _data.imagData() + o * tLength, _direction); });
+        }
+        else
+        {
+            const std::size_t tBundles = (tInner + kBundle - 1) / kBundle;
+            complexParallelFor(tOuter * tBundles, _threads, [&](std::size_t _begin, std::size_t _end)
+                               {
+                std::vector<T> tRe(kBundle * tLength);
+                std::vector<T> tImg(kBundle * tLength);
+                for (std::size_t tTask = _begin; tTask < _end; ++tTask)
+                {
+                    const std::size_t tBase = (tTask / tBundles) * tLength * tInner;
+                    const std::size_t tFirst = (tTask % tBundles) * kBundle;
+                    const std::size_t tCount = std::min(kBundle, tInner - tFirst);
+                    for (std::size_t m = 0; m < tLength; ++m)
+                    {
+                        const std::size_t tOffset = tBase + m * tInner + tFirst;
+                        for (std::size_t l = 0; l < tCount; ++l)
+                        {
+                            tRe[l * tLength + m] = _data.realData()[tOffset + l];
+                            tImg[l * tLength + m] = _data.imagData()[tOffset + l];
+                        }
+                    }
+                    for (std::size_t l = 0; l < tCount; ++l)
+                        tPlan.transform(tRe.data() + l * tLength, tImg.data() + l * tLength, _direction);
+                    for (std::size_t m = 0; m < tLength; ++m)
+                    {
+                        const std::size_t tOffset = tBase + m * tInner + tFirst;
+                        for (std::size_t l = 0; l < tCount; ++l)
+                        {
+                            _data.realData()[tOffset + l] = tRe[l * tLength + m];
+                            _data.imagData()[tOffset + l] = tImg[l * tLength + m];
+                        }
+                    }
+                } });
+        }
+        tOuter *= tLength;
+    }
+}
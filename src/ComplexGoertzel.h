@@ -0,0 +1,272 @@
+#pragma once
+
+#include <vector>
+#include <memory_resource>
+#include <algorithm>
+#include <span>
+#include <numbers>
+#include <stdexcept>
+#include <limits>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+
+// Incremental single-bin spectral analysis.
+// Both trackers keep their per-bin state in separate planes so that one input sample updates all
+// bins in a single vectorizable loop, which costs O(1) per sample and bin instead of a full FFT per window.
+
+// Goertzel filter bank: evaluates the DFT at arbitrary (also fractional) bins k over consecutive,
+// non-overlapping blocks of _blockLength samples. The filter state is reset after every block.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>, class POW2 = default_pow2<T>, class SQRT = default_sqrt<T>, class ATAN = default_atan<T>>
+class GoertzelBank
+{
+private:
+    std::size_t mBlockLength = 0;
+    std::size_t mCount = 0;
+    std::size_t mBlocksCompleted = 0;
+    std::pmr::vector<T> mCoeff;
+    std::pmr::vector<T> mCos;
+    std::pmr::vector<T> mSin;
+    std::pmr::vector<T> mCorrectionCos;
+    std::pmr::vector<T> mCorrectionSin;
+    std::pmr::vector<T> mS1Re;
+    std::pmr::vector<T> mS1Img;
+    std::pmr::vector<T> mS2Re;
+    std::pmr::vector<T> mS2Img;
+    std::pmr::vector<T> mResultRe;
+    std::pmr::vector<T> mResultImg;
+    SIN mSinFunction;
+    COS mCosFunction;
+
+    void finishBlock() noexcept
+    {
+        const std::size_t tBins = mCoeff.size();
+        for (std::size_t i = 0; i < tBins; ++i)
+        {
+            // y = s1 - e^(-jw) * s2, X = e^(-jw(N-1)) * y
+            const T tYRe = mS1Re[i] - (mCos[i] * mS2Re[i] + mSin[i] * mS2Img[i]);
+            const T tYImg = mS1Img[i] - (mCos[i] * mS2Img[i] - mSin[i] * mS2Re[i]);
+            mResultRe[i] = tYRe * mCorrectionCos[i] - tYImg * mCorrectionSin[i];
+            mResultImg[i] = tYImg * mCorrectionCos[i] + tYRe * mCorrectionSin[i];
+            mS1Re[i] = mS1Img[i] = mS2Re[i] = mS2Img[i] = 0;
+        }
+        mCount = 0;
+        ++mBlocksCompleted;
+    }
+
+public:
+    GoertzelBank(std::size_t _blockLength, std::span<const T> _bins, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mBlockLength(_blockLength), mCoeff(_bins.size(), _resource), mCos(_bins.size(), _resource), mSin(_bins.size(), _resource), mCorrectionCos(_bins.size(), _resource), mCorrectionSin(_bins.size(), _resource),
+          mS1Re(_bins.size(), _resource), mS1Img(_bins.size(), _resource), mS2Re(_bins.size(), _resource), mS2Img(_bins.size(), _resource), mResultRe(_bins.size(), _resource), mResultImg(_bins.size(), _resource)
+    {
+        if (_blockLength == 0)
+            throw std::invalid_argument("GoertzelBank: block length must not be 0");
+
+        for (std::size_t i = 0; i < _bins.size(); ++i)
+        {
+            const T tOmega = static_cast<T>(2 * std::numbers::pi_v<T> * _bins[i] / static_cast<T>(_blockLength));
+            mCos[i] = mCosFunction(tOmega);
+            mSin[i] = mSinFunction(tOmega);
+            mCoeff[i] = 2 * mCos[i];
+            const T tCorrection = -tOmega * static_cast<T>(_blockLength - 1);
+            mCorrectionCos[i] = mCosFunction(tCorrection);
+            mCorrectionSin[i] = mSinFunction(tCorrection);
+        }
+    }
+
+    [[nodiscard]] std::size_t getBinCount() const noexcept { return mCoeff.size(); }
+    [[nodiscard]] std::size_t getBlockLength() const noexcept { return mBlockLength; }
+    [[nodiscard]] std::size_t getBlocksCompleted() const noexcept { return mBlocksCompleted; }
+
+    // Returns true if the sample completed a block, the bin values are updated then.
+    bool update(const T &_re, const T &_img) noexcept
+    {
+        const std::size_t tBins = mCoeff.size();
+        for (std::size_t i = 0; i < tBins; ++i)
+        {
+            const T tS0Re = _re + mCoeff[i] * mS1Re[i] - mS2Re[i];
+            const T tS0Img = _img + mCoeff[i] * mS1Img[i] - mS2Img[i];
+            mS2Re[i] = mS1Re[i];
+            mS2Img[i] = mS1Img[i];
+            mS1Re[i] = tS0Re;
+            mS1Img[i] = tS0Img;
+        }
+        if (++mCount == mBlockLength)
+        {
+            finishBlock();
+            return true;
+        }
+        return false;
+    }
+
+    bool update(const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_sample) noexcept
+    {
+        return update(_sample.getReal(), _sample.getImaginary());
+    }
+
+    // _onBlock() is called after every completed block, while the bin values of that block are available.
+    template <ComplexReadableView IN, class ON_BLOCK>
+    void process(const IN &_in, ON_BLOCK &&_onBlock) noexcept(noexcept(_onBlock(*this)))
+    {
+        for (std::size_t i = 0; i < _in.size(); ++i)
+            if (update(_in.real(i), _in.imag(i)))
+                _onBlock(*this);
+    }
+
+    template <ComplexReadableView IN>
+    void process(const IN &_in) noexcept
+    {
+        process(_in, [](const GoertzelBank &) noexcept {});
+    }
+
+    [[nodiscard]] Complex<T, SIN, COS, POW2, SQRT, ATAN> getBin(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<T>)
+    {
+        return Complex<T, SIN, COS, POW2, SQRT, ATAN>(mResultRe[_index], mResultImg[_index]);
+    }
+    [[nodiscard]] ComplexSplitSpan<const T> getBins() const noexcept
+    {
+        return ComplexSplitSpan<const T>(mResultRe.data(), mResultImg.data(), mResultRe.size());
+    }
+
+    void reset() noexcept
+    {
+        for (std::size_t i = 0; i < mCoeff.size(); ++i)
+            mS1Re[i] = mS1Img[i] = mS2Re[i] = mS2Img[i] = mResultRe[i] = mResultImg[i] = 0;
+        mCount = 0;
+        mBlocksCompleted = 0;
+    }
+};
+
+// Sliding DFT: tracks integer bins k of the DFT over the last _windowLength samples, updated on every sample with
+// X(k) = e^(j2pi k/N) * (X(k) + x[n] - x[n-N]).
+// Rounding errors of the recursion accumulate, so every _reanchorInterval samples the bins are recomputed exactly
+// from the sample history (O(N) per bin, amortized O(1) per sample for an interval of N).
+// An interval of 0 selects the window length, kSlidingDFTNoReanchor disables the automatic reanchoring.
+constexpr std::size_t kSlidingDFTNoReanchor = std::numeric_limits<std::size_t>::max();
+
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>, class POW2 = default_pow2<T>, class SQRT = default_sqrt<T>, class ATAN = default_atan<T>>
+class SlidingDFT
+{
+private:
+    std::size_t mWindowLength = 0;
+    std::size_t mReanchorInterval = 0;
+    std::size_t mSinceReanchor = 0;
+    std::size_t mPosition = 0;
+    std::pmr::vector<std::size_t> mBins;
+    std::pmr::vector<T> mTwiddleCos;
+    std::pmr::vector<T> mTwiddleSin;
+    std::pmr::vector<T> mRotateCos;
+    std::pmr::vector<T> mRotateSin;
+    std::pmr::vector<T> mHistoryRe;
+    std::pmr::vector<T> mHistoryImg;
+    std::pmr::vector<T> mBinRe;
+    std::pmr::vector<T> mBinImg;
+    SIN mSinFunction;
+    COS mCosFunction;
+
+public:
+    SlidingDFT(std::size_t _windowLength, std::span<const std::size_t> _bins, std::size_t _reanchorInterval = 0, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mWindowLength(_windowLength), mReanchorInterval(_reanchorInterval == 0 ? _windowLength : _reanchorInterval), mBins(_bins.begin(), _bins.end(), _resource),
+          mTwiddleCos(_windowLength, _resource), mTwiddleSin(_windowLength, _resource), mRotateCos(_bins.size(), _resource), mRotateSin(_bins.size(), _resource),
+          mHistoryRe(_windowLength, _resource), mHistoryImg(_windowLength, _resource), mBinRe(_bins.size(), _resource), mBinImg(_bins.size(), _resource)
+    {
+        if (_windowLength == 0)
+            throw std::invalid_argument("SlidingDFT: window length must not be 0");
+
+        for (std::size_t i = 0; i < _windowLength; ++i)
+        {
+            const T tAngle = static_cast<T>(2 * std::numbers::pi_v<T> * static_cast<T>(i) / static_cast<T>(_windowLength));
+            mTwiddleCos[i] = mCosFunction(tAngle);
+            mTwiddleSin[i] = mSinFunction(tAngle);
+        }
+        for (std::size_t i = 0; i < mBins.size(); ++i)
+        {
+            if (mBins[i] >= _windowLength)
+                throw std::invalid_argument("SlidingDFT: bin index out of range");
+            mRotateCos[i] = mTwiddleCos[mBins[i]];
+            mRotateSin[i] = mTwiddleSin[mBins[i]];
+        }
+    }
+
+    [[nodiscard]] std::size_t getBinCount() const noexcept { return mBins.size(); }
+    [[nodiscard]] std::size_t getWindowLength() const noexcept { return mWindowLength; }
+
+    void update(const T &_re, const T &_img) noexcept
+    {
+        const T tDeltaRe = _re - mHistoryRe[mPosition];
+        const T tDeltaImg = _img - mHistoryImg[mPosition];
+        mHistoryRe[mPosition] = _re;
+        mHistoryImg[mPosition] = _img;
+        if (++mPosition == mWindowLength)
+            mPosition = 0;
+
+        const std::size_t tBins = mBins.size();
+        for (std::size_t i = 0; i < tBins; ++i)
+        {
+            const T tRe = mBinRe[i] + tDeltaRe;
+            const T tImg = mBinImg[i] + tDeltaImg;
+            mBinRe[i] = tRe * mRotateCos[i] - tImg * mRotateSin[i];
+            mBinImg[i] = tRe * mRotateSin[i] + tImg * mRotateCos[i];
+        }
+
+        if (++mSinceReanchor >= mReanchorInterval)
+            reanchor();
+    }
+
+    void update(const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_sample) noexcept
+    {
+        update(_sample.getReal(), _sample.getImaginary());
+    }
+
+    template <ComplexReadableView IN>
+    void process(const IN &_in) noexcept
+    {
+        for (std::size_t i = 0; i < _in.size(); ++i)
+            update(_in.real(i), _in.imag(i));
+    }
+
+    // Recomputes all bins directly from the history: X(k) = sum_m x[oldest + m] * e^(-j2pi k m/N).
+    void reanchor() noexcept
+    {
+        for (std::size_t i = 0; i < mBins.size(); ++i)
+        {
+            T tRe = 0;
+            T tImg = 0;
+            std::size_t tTwiddle = 0;
+            for (std::size_t m = 0; m < mWindowLength; ++m)
+            {
+                std::size_t tSample = mPosition + m;
+                if (tSample >= mWindowLength)
+                    tSample -= mWindowLength;
+                tRe += mHistoryRe[tSample] * mTwiddleCos[tTwiddle] + mHistoryImg[tSample] * mTwiddleSin[tTwiddle];
+                tImg += mHistoryImg[tSample] * mTwiddleCos[tTwiddle] - mHistoryRe[tSample] * mTwiddleSin[tTwiddle];
+                tTwiddle += mBins[i];
+                if (tTwiddle >= mWindowLength)
+                    tTwiddle -= mWindowLength;
+            }
+            mBinRe[i] = tRe;
+            mBinImg[i] = tImg;
+        }
+        mSinceReanchor = 0;
+    }
+
+    [[nodiscard]] Complex<T, SIN, COS, POW2, SQRT, ATAN> getBin(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<T>)
+    {
+        return Complex<T, SIN, COS, POW2, SQRT, ATAN>(mBinRe[_index], mBinImg[_index]);
+    }
+    [[nodiscard]] ComplexSplitSpan<const T> getBins() const noexcept
+    {
+        return ComplexSplitSpan<const T>(mBinRe.data(), mBinImg.data(), mBinRe.size());
+    }
+
+    void reset() noexcept
+    {
+        std::fill(mHistoryRe.begin(), mHistoryRe.end(), T{0});
+        std::fill(mHistoryImg.begin(), mHistoryImg.end(), T{0});
+        std::fill(mBinRe.begin(), mBinRe.end(), T{0});
+        std::fill(mBinImg.begin(), mBinImg.end(), T{0});
+        mPosition = 0;
+        mSinceReanchor = 0;
+    }
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "Complex.h"
+#include "ComplexView.h"
+
+// Memory resources for request scoped computations and an allocator aware owning container.
+// Every container of the library (ComplexBuffer, the FFT plans, the spectral trackers, ...) accepts a
+// std::pmr::memory_resource or allocator, so all memory of one request can come from a ComplexArena and be
+// dropped at once with reset() or release().
+
+// Owning split-plane buffer, the allocator is used for both planes.
+template <typename T, class Allocator = std::allocator<T>>
+class ComplexBuffer
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+private:
+    std::vector<T, Allocator> mRe;
+    std::vector<T, Allocator> mImg;
+
+public:
+    explicit ComplexBuffer(const Allocator &_allocator = Allocator()) noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
+        : mRe(_allocator), mImg(_allocator)
+    {
+    }
+    explicit ComplexBuffer(std::size_t _size, const Allocator &_allocator = Allocator()) noexcept(false)
+        : mRe(_size, _allocator), mImg(_size, _allocator)
+    {
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return mRe.get_allocator(); }
+    [[nodiscard]] std::size_t size() const noexcept { return mRe.size(); }
+    [[nodiscard]] bool empty() const noexcept { return mRe.empty(); }
+
+    void resize(std::size_t _size) noexcept(false)
+    {
+        mRe.resize(_size);
+        mImg.resize(_size);
+    }
+    void clear() noexcept
+    {
+        mRe.clear();
+        mImg.clear();
+    }
+
+    [[nodiscard]] const T &real(std::size_t _index) const noexcept { return mRe[_index]; }
+    [[nodiscard]] const T &imag(std::size_t _index) const noexcept { return mImg[_index]; }
+    void set(std::size_t _index, const T &_re, const T &_img) noexcept
+    {
+        mRe[_index] = _re;
+        mImg[_index] = _img;
+    }
+
+    template <class C = Complex<T>>
+    [[nodiscard]] C load(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<T>)
+    {
+        return C(mRe[_index], mImg[_index]);
+    }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    void store(std::size_t _index, const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_complex) noexcept
+    {
+        set(_index, _complex.getReal(), _complex.getImaginary());
+    }
+
+    [[nodiscard]] ComplexSplitSpan<T> view() noexcept { return ComplexSplitSpan<T>(mRe.data(), mImg.data(), mRe.size()); }
+    [[nodiscard]] ComplexSplitSpan<const T> view() const noexcept { return ComplexSplitSpan<const T>(mRe.data(), mImg.data(), mRe.size()); }
+};
+
+template <typename T>
+using PmrComplexBuffer = ComplexBuffer<T, std::pmr::polymorphic_allocator<T>>;
+
+// Bump allocator: allocations are carved sequentially out of large blocks and deallocate() is a no-op.
+// reset() rewinds the arena and keeps its blocks for the next request, release() returns them to the system.
+// Blocks of at least kHugePageSize are aligned to and sized in whole huge pages and, on Linux, advised for
+// transparent huge pages, which cuts TLB misses on large complex buffers.
+// Not thread safe: use one arena per request or thread.
+class ComplexArena final : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+    static constexpr std::size_t kCacheLineSize = 64;
+
+private:
+    struct Block
+    {
+        std::byte *data = nullptr;
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+    };
+
+    std::vector<Block> mBlocks;
+    std::size_t mBlockSize = kHugePageSize;
+    std::size_t mCurrentBlock = 0;
+    std::size_t mOffset = 0;
+    std::size_t mBytesAllocated = 0;
+
+    [[nodiscard]] static Block allocateBlock(std::size_t _size) noexcept(false)
+    {
+        Block tBlock;
+        tBlock.alignment = _size >= kHugePageSize ? kHugePageSize : kCacheLineSize;
+        tBlock.size = (_size + tBlock.alignment - 1) / tBlock.alignment * tBlock.alignment;
+        tBlock.data = static_cast<std::byte *>(::operator new(tBlock.size, std::align_val_t(tBlock.alignment)));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (tBlock.alignment == kHugePageSize)
+            ::madvise(tBlock.data, tBlock.size, MADV_HUGEPAGE);
+#endif
+        return tBlock;
+    }
+
+    void *do_allocate(std::size_t _bytes, std::size_t _alignment) override
+    {
+        for (; mCurrentBlock < mBlocks.size(); ++mCurrentBlock, mOffset = 0)
+        {
+            const Block &tBlock = mBlocks[mCurrentBlock];
+            const std::uintptr_t tBase = reinterpret_cast<std::uintptr_t>(tBlock.data);
+            const std::uintptr_t tAligned = (tBase + mOffset + _alignment - 1) / _alignment * _alignment;
+            if (tAligned + _bytes <= tBase + tBlock.size)
+            {
+                mOffset = tAligned + _bytes - tBase;
+                mBytesAllocated += _bytes;
+                return tBlock.data + (tAligned - tBase);
+            }
+        }
+
+        // Room for the record first: once the block exists, recording it must not throw.
+        if (mBlocks.size() == mBlocks.capacity())
+            mBlocks.reserve(2 * mBlocks.size() + 1);
+        mBlocks.push_back(allocateBlock(std::max(mBlockSize, _bytes + _alignment)));
+        mCurrentBlock = mBlocks.size() - 1;
+        mOffset = 0;
+        return do_allocate(_bytes, _alignment);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) noexcept override
+    {
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override
+    {
+        return this == &_other;
+    }
+
+public:
+    explicit ComplexArena(std::size_t _blockSize = kHugePageSize) noexcept
+        : mBlockSize(_blockSize == 0 ? kHugePageSize : _blockSize)
+    {
+    }
+    ComplexArena(const ComplexArena &) = delete;
+    ComplexArena &operator=(const ComplexArena &) = delete;
+    ~ComplexArena() override
+    {
+        release();
+    }
+
+    // Bytes handed out since the last reset()/release().
+    [[nodiscard]] std::size_t getBytesAllocated() const noexcept { return mBytesAllocated; }
+    // Bytes held in blocks.
+    [[nodiscard]] std::size_t getCapacity() const noexcept
+    {
+        std::size_t tCapacity = 0;
+        for (const auto &tBlock : mBlocks)
+            tCapacity += tBlock.size;
+        return tCapacity;
+    }
+
+    void reset() noexcept
+    {
+        mCurrentBlock = 0;
+        mOffset = 0;
+        mBytesAllocated = 0;
+    }
+
+    void release() noexcept
+    {
+        for (const auto &tBlock : mBlocks)
+            ::operator delete(tBlock.data, tBlock.size, std::align_val_t(tBlock.alignment));
+        mBlocks.clear();
+        reset();
+    }
+};
+
+// Size class pool: requests up to _maxClassSize bytes are rounded up to a power of 2 (at least kMinClassSize)
+// and served from per class free lists, so fixed-size complex buffers are recycled without touching the heap.
+// Larger or over-aligned requests go to the upstream resource directly.
+// Not thread safe, like std::pmr::unsynchronized_pool_resource.
+class ComplexPool final : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t kMinClassSize = 64;
+
+private:
+    struct FreeNode
+    {
+        FreeNode *next = nullptr;
+    };
+    struct Chunk
+    {
+        void *data = nullptr;
+        std::size_t size = 0;
+    };
+
+    std::pmr::memory_resource *mUpstream = nullptr;
+    std::size_t mMaxClassSize = 0;
+    std::size_t mChunkSize = 0;
+    std::vector<FreeNode *> mFreeLists;
+    std::vector<Chunk> mChunks;
+
+    [[nodiscard]] static std::size_t classIndex(std::size_t _bytes) noexcept
+    {
+        std::size_t tIndex = 0;
+        for (std::size_t tSize = kMinClassSize; tSize < _bytes; tSize <<= 1)
+            ++tIndex;
+        return tIndex;
+    }
+    [[nodiscard]] bool isPooled(std::size_t _bytes, std::size_t _alignment) const noexcept
+    {
+        return _bytes <= mMaxClassSize && _alignment <= kMinClassSize;
+    }
+
+    void *do_allocate(std::size_t _bytes, std::size_t _alignment) override
+    {
+        if (!isPooled(_bytes, _alignment))
+            return mUpstream->allocate(_bytes, _alignment);
+
+        const std::size_t tIndex = classIndex(_bytes);
+        if (mFreeLists[tIndex] == nullptr)
+        {
+            const std::size_t tClassSize = kMinClassSize << tIndex;
+            const std::size_t tChunkSize = std::max(mChunkSize, tClassSize);
+            // Room for the record first: once the chunk exists, recording it must not throw.
+            if (mChunks.size() == mChunks.capacity())
+                mChunks.reserve(2 * mChunks.size() + 1);
+            auto *tChunk = static_cast<std::byte *>(mUpstream->allocate(tChunkSize, kMinClassSize));
+            mChunks.push_back({tChunk, tChunkSize});
+            for (std::size_t tOffset = 0; tOffset + tClassSize <= tChunkSize; tOffset += tClassSize)
+                mFreeLists[tIndex] = ::new (tChunk + tOffset) FreeNode{mFreeLists[tIndex]};
+        }
+
+        FreeNode *tNode = mFreeLists[tIndex];
+        mFreeLists[tIndex] = tNode->next;
+        return tNode;
+    }
+
+    void do_deallocate(void *_pointer, std::size_t _bytes, std::size_t _alignment) override
+    {
+        if (!isPooled(_bytes, _alignment))
+            return mUpstream->deallocate(_pointer, _bytes, _alignment);
+
+        const std::size_t tIndex = classIndex(_bytes);
+        mFreeLists[tIndex] = ::new (_pointer) FreeNode{mFreeLists[tIndex]};
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override
+    {
+        return this == &_other;
+    }
+
+public:
+    explicit ComplexPool(std::size_t _maxClassSize = std::size_t{1} << 20, std::size_t _chunkSize = std::size_t{1} << 20, std::pmr::memory_resource *_upstream = std::pmr::new_delete_resource()) noexcept(false)
+        : mUpstream(_upstream), mMaxClassSize(std::max(_maxClassSize, kMinClassSize)), mChunkSize(_chunkSize), mFreeLists(classIndex(mMaxClassSize) + 1, nullptr)
+    {
+    }
+    ComplexPool(const ComplexPool &) = delete;
+    ComplexPool &operator=(const ComplexPool &) = delete;
+    ~ComplexPool() override
+    {
+        release();
+    }
+
+    [[nodiscard]] std::pmr::memory_resource *getUpstream() const noexcept { return mUpstream; }
+
+    // Returns all pooled memory to the upstream resource, outstanding pooled allocations become invalid.
+    void release() noexcept
+    {
+        for (const auto &tChunk : mChunks)
+            mUpstream->deallocate(tChunk.data, tChunk.size, kMinClassSize);
+        mChunks.clear();
+        std::fill(mFreeLists.begin(), mFreeLists.end(), nullptr);
+    }
+};
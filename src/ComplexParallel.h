@@ -0,0 +1,227 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <deque>
+#include <span>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <algorithm>
+#include <cstddef>
+
+// Minimal fork/join helper for the batch kernels.
+// The index range is always cut into the same contiguous chunks for a given thread count and every chunk is
+// processed by exactly one thread, so kernels that combine chunk results in chunk order stay deterministic.
+// Chunks run on a process wide pool of persistent workers (ComplexThreadPool), so a parallel call costs a queue
+// hand-off instead of thread creation, and every worker keeps its index for the lifetime of the process.
+
+// Resolves a requested thread count, 0 selects one thread per hardware thread.
+[[nodiscard]] inline std::size_t complexThreadCount(std::size_t _requested = 0) noexcept
+{
+    if (_requested != 0)
+        return _requested;
+    const std::size_t tHardware = std::thread::hardware_concurrency();
+    return tHardware == 0 ? 1 : tHardware;
+}
+
+// Index of the calling thread: 1..N for the workers of ComplexThreadPool, 0 for every other thread.
+[[nodiscard]] inline std::size_t &complexWorkerSlot() noexcept
+{
+    thread_local std::size_t tIndex = 0;
+    return tIndex;
+}
+[[nodiscard]] inline std::size_t complexWorkerIndex() noexcept
+{
+    return complexWorkerSlot();
+}
+
+// Persistent workers executing the chunks of complexParallelFor calls. The pool grows on demand up to the largest
+// thread count requested so far and is joined at process exit. A caller waiting for its chunks executes queued
+// chunks meanwhile, so nested parallel calls from inside a chunk cannot deadlock.
+class ComplexThreadPool
+{
+public:
+    // One parallel call: pending is guarded by the pool mutex.
+    struct Batch
+    {
+        void (*invoke)(const void *, std::size_t, std::size_t) noexcept;
+        const void *context;
+        std::size_t pending;
+    };
+
+private:
+    struct Task
+    {
+        Batch *batch;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mDone;
+    std::deque<Task> mQueue;
+    std::vector<std::thread> mWorkers;
+    bool mStop = false;
+
+    ComplexThreadPool() = default;
+
+    // Runs _task with the lock released and reacquires it.
+    void execute(const Task &_task, std::unique_lock<std::mutex> &_lock) noexcept
+    {
+        _lock.unlock();
+        _task.batch->invoke(_task.batch->context, _task.begin, _task.end);
+        _lock.lock();
+        if (--_task.batch->pending == 0)
+            mDone.notify_all();
+    }
+
+    void work(std::size_t _index) noexcept
+    {
+        complexWorkerSlot() = _index;
+        std::unique_lock tLock(mMutex);
+        for (;;)
+        {
+            mWork.wait(tLock, [this]() noexcept
+                       { return mStop || !mQueue.empty(); });
+            if (mQueue.empty())
+                return;
+            const Task tTask = mQueue.front();
+            mQueue.pop_front();
+            execute(tTask, tLock);
+        }
+    }
+
+public:
+    ComplexThreadPool(const ComplexThreadPool &) = delete;
+    ComplexThreadPool &operator=(const ComplexThreadPool &) = delete;
+    ~ComplexThreadPool()
+    {
+        {
+            std::lock_guard tLock(mMutex);
+            mStop = true;
+        }
+        mWork.notify_all();
+        for (auto &tWorker : mWorkers)
+            tWorker.join();
+    }
+
+    [[nodiscard]] static ComplexThreadPool &instance() noexcept
+    {
+        static ComplexThreadPool sPool;
+        return sPool;
+    }
+
+    [[nodiscard]] std::size_t getWorkerCount() noexcept
+    {
+        std::lock_guard tLock(mMutex);
+        return mWorkers.size();
+    }
+
+    // Starts workers until there are at least _workers. Workers started before a failure stay in the pool.
+    void reserve(std::size_t _workers) noexcept(false)
+    {
+        std::lock_guard tLock(mMutex);
+        if (mWorkers.size() >= _workers)
+            return;
+        mWorkers.reserve(_workers);
+        while (mWorkers.size() < _workers)
+            mWorkers.emplace_back(&ComplexThreadPool::work, this, mWorkers.size() + 1);
+    }
+
+    // Queues the ranges [_bounds[i], _bounds[i + 1]) of _batch, _batch.pending must equal their number.
+    // If queueing fails nothing of _batch stays queued.
+    void submit(Batch &_batch, std::span<const std::size_t> _bounds) noexcept(false)
+    {
+        {
+            std::lock_guard tLock(mMutex);
+            const std::size_t tQueued = mQueue.size();
+            try
+            {
+                for (std::size_t i = 0; i + 1 < _bounds.size(); ++i)
+                    mQueue.push_back({&_batch, _bounds[i], _bounds[i + 1]});
+            }
+            catch (...)
+            {
+                mQueue.resize(tQueued);
+                throw;
+            }
+        }
+        mWork.notify_all();
+    }
+
+    // Returns once every range of _batch ran, executing queued ranges of any batch meanwhile.
+    void wait(Batch &_batch) noexcept
+    {
+        std::unique_lock tLock(mMutex);
+        while (_batch.pending != 0)
+        {
+            if (mQueue.empty())
+            {
+                mDone.wait(tLock);
+                continue;
+            }
+            const Task tTask = mQueue.front();
+            mQueue.pop_front();
+            execute(tTask, tLock);
+        }
+    }
+};
+
+// Calls _function(begin, end) for contiguous sub ranges of [0, _count) on up to _threads threads, but never
+// with fewer than _grain indices per range: below 2 * _grain the call runs inline on the calling thread.
+// The calling thread processes the first range. The first exception thrown by any range is rethrown after all ranges finished.
+template <class F>
+void complexParallelFor(std::size_t _count, std::size_t _threads, F &&_function, std::size_t _grain = 1) noexcept(false)
+{
+    const std::size_t tThreads = std::min(complexThreadCount(_threads), _count / std::max<std::size_t>(1, _grain));
+    if (tThreads <= 1)
+    {
+        if (_count != 0)
+            _function(std::size_t{0}, _count);
+        return;
+    }
+
+    std::exception_ptr tException;
+    std::mutex tExceptionMutex;
+    const auto tRun = [&](std::size_t _begin, std::size_t _end) noexcept
+    {
+        try
+        {
+            _function(_begin, _end);
+        }
+        catch (...)
+        {
+            const std::lock_guard tLock(tExceptionMutex);
+            if (!tException)
+                tException = std::current_exception();
+        }
+    };
+
+    std::vector<std::size_t> tBounds(tThreads + 1);
+    const std::size_t tChunk = _count / tThreads;
+    const std::size_t tRemainder = _count % tThreads;
+    for (std::size_t i = 0; i < tThreads; ++i)
+        tBounds[i + 1] = tBounds[i] + tChunk + (i < tRemainder ? 1 : 0);
+
+    auto &tPool = ComplexThreadPool::instance();
+    try
+    {
+        tPool.reserve(tThreads - 1);
+    }
+    catch (const std::system_error &)
+    {
+        // No more threads available: the waiting caller executes the chunks the pool cannot take.
+    }
+    ComplexThreadPool::Batch tBatch{[](const void *_context, std::size_t _begin, std::size_t _end) noexcept
+                                    { (*static_cast<const decltype(tRun) *>(_context))(_begin, _end); },
+                                    &tRun, tThreads - 1};
+    tPool.submit(tBatch, std::span<const std::size_t>(tBounds).subspan(1));
+    tRun(tBounds[0], tBounds[1]);
+    tPool.wait(tBatch);
+
+    if (tException)
+        std::rethrow_exception(tException);
+}
@@ -0,0 +1,433 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+#endif
+
+#include "ComplexParallel.h"
+
+// Hardware performance counters around marked regions.
+// On Linux every thread lazily opens one perf_event_open counter per PerfEvent for itself (user space only, so the
+// default perf_event_paranoid level is sufficient). Counters that the kernel, the CPU or a container refuses are
+// reported as invalid; everywhere else (and on other platforms) only calls, elements and wall clock time are recorded.
+// A PerfRegion snapshots the counters of the calling thread on construction and adds the difference to the
+// PerfRegistry on destruction, keyed by region name and complexWorkerIndex(), so results can be read from code or
+// dumped as JSON. The workers of ComplexThreadPool live for the whole process, so they open their counters once and
+// each keeps one entry per region; all other threads (the caller of a parallel kernel, pipeline stages, user threads)
+// share worker index 0 and are merged into one entry per region, which keeps the registry bounded by regions x workers.
+// Library kernels mark their parallel chunks with COMPLEX_PERF_REGION from ComplexPerfRegion.h, which pulls in this
+// header only if COMPLEX_ENABLE_PERF is defined for the whole program.
+
+enum class PerfEvent : std::size_t
+{
+    Cycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    // Microcode assists for denormal operands/results, only available on the Intel cores perfFPAssistConfig() knows.
+    FPAssists
+};
+
+constexpr std::size_t kPerfEventCount = 5;
+
+[[nodiscard]] constexpr const char *perfEventName(PerfEvent _event) noexcept
+{
+    switch (_event)
+    {
+    case PerfEvent::Cycles:
+        return "cycles";
+    case PerfEvent::Instructions:
+        return "instructions";
+    case PerfEvent::CacheMisses:
+        return "cacheMisses";
+    case PerfEvent::BranchMisses:
+        return "branchMisses";
+    case PerfEvent::FPAssists:
+        return "fpAssists";
+    }
+    return "unknown";
+}
+
+struct PerfCounters
+{
+    std::array<std::uint64_t, kPerfEventCount> values{};
+    std::array<bool, kPerfEventCount> valid{};
+    std::uint64_t calls = 0;
+    std::uint64_t elements = 0;
+    double seconds = 0;
+
+    [[nodiscard]] bool isValid(PerfEvent _event) const noexcept { return valid[static_cast<std::size_t>(_event)]; }
+    [[nodiscard]] std::uint64_t get(PerfEvent _event) const noexcept { return values[static_cast<std::size_t>(_event)]; }
+
+    // NaN if the counter is not available or no elements were recorded.
+    [[nodiscard]] double perElement(PerfEvent _event) const noexcept
+    {
+        if (!isValid(_event) || elements == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+        return static_cast<double>(get(_event)) / static_cast<double>(elements);
+    }
+    [[nodiscard]] double nanosecondsPerElement() const noexcept
+    {
+        return elements == 0 ? std::numeric_limits<double>::quiet_NaN() : seconds * 1e9 / static_cast<double>(elements);
+    }
+    // Instructions per cycle, NaN if either counter is not available.
+    [[nodiscard]] double ipc() const noexcept
+    {
+        if (!isValid(PerfEvent::Cycles) || !isValid(PerfEvent::Instructions) || get(PerfEvent::Cycles) == 0)
+            return std::numeric_limits<double>::quiet_NaN();
+        return static_cast<double>(get(PerfEvent::Instructions)) / static_cast<double>(get(PerfEvent::Cycles));
+    }
+
+    PerfCounters &operator+=(const PerfCounters &_counters) noexcept
+    {
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+            // A counter stays valid only if it was valid for every accumulated sample.
+            valid[i] = (calls == 0 ? _counters.valid[i] : valid[i] && _counters.valid[i]);
+            values[i] += _counters.values[i];
+        }
+        calls += _counters.calls;
+        elements += _counters.elements;
+        seconds += _counters.seconds;
+        return *this;
+    }
+};
+
+// Raw event encoding of the FP assist counter for the CPU we run on, 0 if it has none or it is unknown:
+// FP_ASSIST.ANY (event 0xCA, umask 0x1E) from Sandy Bridge to Comet Lake, ASSISTS.FP (event 0xC1, umask 0x02) from
+// Ice Lake on. Other vendors and families reuse these encodings for unrelated events, so they are not programmed.
+[[nodiscard]] inline std::uint64_t perfFPAssistConfig() noexcept
+{
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned tEax = 0;
+    unsigned tEbx = 0;
+    unsigned tEcx = 0;
+    unsigned tEdx = 0;
+    // Vendor string "GenuineIntel" in EBX, EDX, ECX.
+    if (__get_cpuid(0, &tEax, &tEbx, &tEcx, &tEdx) == 0 || tEbx != 0x756E6547 || tEdx != 0x49656E69 || tEcx != 0x6C65746E)
+        return 0;
+    if (__get_cpuid(1, &tEax, &tEbx, &tEcx, &tEdx) == 0 || ((tEax >> 8) & 0xF) != 6)
+        return 0;
+    switch (((tEax >> 4) & 0xF) | (((tEax >> 16) & 0xF) << 4))
+    {
+    case 0x2A: // Sandy Bridge
+    case 0x2D:
+    case 0x3A: // Ivy Bridge
+    case 0x3E:
+    case 0x3C: // Haswell
+    case 0x3F:
+    case 0x45:
+    case 0x46:
+    case 0x3D: // Broadwell
+    case 0x47:
+    case 0x4F:
+    case 0x56:
+    case 0x4E: // Skylake ... Comet Lake
+    case 0x5E:
+    case 0x55:
+    case 0x8E:
+    case 0x9E:
+    case 0xA5:
+    case 0xA6:
+        return 0x1ECA;
+    case 0x7D: // Ice Lake
+    case 0x7E:
+    case 0x6A:
+    case 0x6C:
+    case 0x8C: // Tiger Lake
+    case 0x8D:
+    case 0x97: // Alder Lake
+    case 0x9A:
+    case 0xB7: // Raptor Lake
+    case 0xBA:
+    case 0xBF:
+    case 0x8F: // Sapphire Rapids
+    case 0xCF: // Emerald Rapids
+        return 0x02C1;
+    default:
+        return 0;
+    }
+#else
+    return 0;
+#endif
+}
+
+// The counters of the calling thread. Not copyable, one instance per thread via perfThreadCounters().
+class PerfCounterGroup
+{
+public:
+    using Snapshot = std::array<std::uint64_t, kPerfEventCount>;
+
+private:
+    std::array<int, kPerfEventCount> mFd;
+
+#if defined(__linux__)
+    [[nodiscard]] static int open(PerfEvent _event) noexcept
+    {
+        perf_event_attr tAttr{};
+        tAttr.size = sizeof(tAttr);
+        tAttr.type = PERF_TYPE_HARDWARE;
+        tAttr.exclude_kernel = 1;
+        tAttr.exclude_hv = 1;
+        tAttr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        switch (_event)
+        {
+        case PerfEvent::Cycles:
+            tAttr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            tAttr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::CacheMisses:
+            tAttr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::BranchMisses:
+            tAttr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::FPAssists:
+        {
+            static const std::uint64_t sConfig = perfFPAssistConfig();
+            if (sConfig == 0)
+                return -1;
+            tAttr.type = PERF_TYPE_RAW;
+            tAttr.config = sConfig;
+            break;
+        }
+        }
+        return static_cast<int>(syscall(SYS_perf_event_open, &tAttr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+#endif
+
+public:
+    PerfCounterGroup() noexcept
+    {
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+#if defined(__linux__)
+            mFd[i] = open(static_cast<PerfEvent>(i));
+#else
+            mFd[i] = -1;
+#endif
+        }
+    }
+    PerfCounterGroup(const PerfCounterGroup &) = delete;
+    PerfCounterGroup &operator=(const PerfCounterGroup &) = delete;
+    ~PerfCounterGroup()
+    {
+#if defined(__linux__)
+        for (const int tFd : mFd)
+            if (tFd >= 0)
+                ::close(tFd);
+#endif
+    }
+
+    [[nodiscard]] bool isValid(PerfEvent _event) const noexcept { return mFd[static_cast<std::size_t>(_event)] >= 0; }
+    [[nodiscard]] bool isAvailable() const noexcept
+    {
+        for (const int tFd : mFd)
+            if (tFd >= 0)
+                return true;
+        return false;
+    }
+
+    // Current counter values, extrapolated if the kernel had to multiplex the counters.
+    [[nodiscard]] Snapshot read() const noexcept
+    {
+        Snapshot tSnapshot{};
+#if defined(__linux__)
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+            if (mFd[i] < 0)
+                continue;
+            std::uint64_t tData[3] = {};
+            if (::read(mFd[i], tData, sizeof(tData)) != static_cast<ssize_t>(sizeof(tData)))
+                continue;
+            tSnapshot[i] = (tData[2] != 0 && tData[2] < tData[1]) ? static_cast<std::uint64_t>(static_cast<double>(tData[0]) * static_cast<double>(tData[1]) / static_cast<double>(tData[2])) : tData[0];
+        }
+#endif
+        return tSnapshot;
+    }
+};
+
+[[nodiscard]] inline PerfCounterGroup &perfThreadCounters() noexcept
+{
+    thread_local PerfCounterGroup tCounters;
+    return tCounters;
+}
+
+struct PerfRegionResult
+{
+    std::string region;
+    // complexWorkerIndex() of the measured threads: 1..N for a pool worker, 0 for all other threads.
+    std::size_t thread = 0;
+    PerfCounters counters;
+};
+
+class PerfRegistry
+{
+private:
+    mutable std::mutex mMutex;
+    std::map<std::pair<std::string, std::size_t>, PerfCounters> mRegions;
+
+    static void writeNumber(std::ostream &_out, double _value) noexcept(false)
+    {
+        if (std::isfinite(_value))
+            _out << _value;
+        else
+            _out << "null";
+    }
+    static void writeString(std::ostream &_out, const std::string &_value) noexcept(false)
+    {
+        _out << '"';
+        for (const char tChar : _value)
+        {
+            if (tChar == '"' || tChar == '\\')
+                _out << '\\' << tChar;
+            else if (static_cast<unsigned char>(tChar) < 0x20)
+                _out << ' ';
+            else
+                _out << tChar;
+        }
+        _out << '"';
+    }
+
+public:
+    [[nodiscard]] static PerfRegistry &instance() noexcept
+    {
+        static PerfRegistry sRegistry;
+        return sRegistry;
+    }
+
+    void add(const std::string &_region, std::size_t _thread, const PerfCounters &_counters) noexcept(false)
+    {
+        std::lock_guard tLock(mMutex);
+        mRegions[{_region, _thread}] += _counters;
+    }
+
+    // One entry per region and worker index, sorted by region name and worker index.
+    [[nodiscard]] std::vector<PerfRegionResult> getResults() const noexcept(false)
+    {
+        std::lock_guard tLock(mMutex);
+        std::vector<PerfRegionResult> tResults;
+        tResults.reserve(mRegions.size());
+        for (const auto &[tKey, tCounters] : mRegions)
+            tResults.push_back({tKey.first, tKey.second, tCounters});
+        return tResults;
+    }
+
+    // The counters of _region summed over all threads.
+    [[nodiscard]] PerfCounters getTotal(const std::string &_region) const noexcept(false)
+    {
+        std::lock_guard tLock(mMutex);
+        PerfCounters tTotal;
+        for (const auto &[tKey, tCounters] : mRegions)
+            if (tKey.first == _region)
+                tTotal += tCounters;
+        return tTotal;
+    }
+
+    void reset() noexcept
+    {
+        std::lock_guard tLock(mMutex);
+        mRegions.clear();
+    }
+
+    // {"regions": [{"region", "thread", "calls", "elements", "seconds", <events>, "ipc", "nsPerElement", <events>PerElement}]}
+    // Unavailable counters are written as null.
+    void writeJson(std::ostream &_out) const noexcept(false)
+    {
+        const auto tResults = getResults();
+        _out << "{\"regions\":[";
+        for (std::size_t r = 0; r < tResults.size(); ++r)
+        {
+            const auto &tCounters = tResults[r].counters;
+            _out << (r == 0 ? "" : ",") << "{\"region\":";
+            writeString(_out, tResults[r].region);
+            _out << ",\"thread\":" << tResults[r].thread << ",\"calls\":" << tCounters.calls << ",\"elements\":" << tCounters.elements << ",\"seconds\":";
+            writeNumber(_out, tCounters.seconds);
+            for (std::size_t i = 0; i < kPerfEventCount; ++i)
+            {
+                const auto tEvent = static_cast<PerfEvent>(i);
+                _out << ",\"" << perfEventName(tEvent) << "\":";
+                if (tCounters.isValid(tEvent))
+                    _out << tCounters.get(tEvent);
+                else
+                    _out << "null";
+            }
+            _out << ",\"ipc\":";
+            writeNumber(_out, tCounters.ipc());
+            _out << ",\"nsPerElement\":";
+            writeNumber(_out, tCounters.nanosecondsPerElement());
+            for (std::size_t i = 0; i < kPerfEventCount; ++i)
+            {
+                const auto tEvent = static_cast<PerfEvent>(i);
+                _out << ",\"" << perfEventName(tEvent) << "PerElement\":";
+                writeNumber(_out, tCounters.perElement(tEvent));
+            }
+            _out << '}';
+        }
+        _out << "]}";
+    }
+};
+
+// Measures the calling thread from construction to destruction. _name must outlive the region (e.g. a literal).
+class PerfRegion
+{
+private:
+    const char *mName;
+    std::uint64_t mElements;
+    PerfCounterGroup &mCounters;
+    PerfCounterGroup::Snapshot mStart;
+    std::chrono::steady_clock::time_point mStartTime;
+
+public:
+    explicit PerfRegion(const char *_name, std::uint64_t _elements = 0) noexcept
+        : mName(_name), mElements(_elements), mCounters(perfThreadCounters()), mStart(mCounters.read()), mStartTime(std::chrono::steady_clock::now())
+    {
+    }
+    PerfRegion(const PerfRegion &) = delete;
+    PerfRegion &operator=(const PerfRegion &) = delete;
+
+    ~PerfRegion()
+    {
+        const auto tEnd = mCounters.read();
+        const std::chrono::duration<double> tElapsed = std::chrono::steady_clock::now() - mStartTime;
+        PerfCounters tCounters;
+        for (std::size_t i = 0; i < kPerfEventCount; ++i)
+        {
+            tCounters.valid[i] = mCounters.isValid(static_cast<PerfEvent>(i));
+            tCounters.values[i] = tEnd[i] - mStart[i];
+        }
+        tCounters.calls = 1;
+        tCounters.elements = mElements;
+        tCounters.seconds = tElapsed.count();
+        try
+        {
+            PerfRegistry::instance().add(mName, complexWorkerIndex(), tCounters);
+        }
+        catch (...)
+        {
+            // Instrumentation must never change the behaviour of the measured code.
+        }
+    }
+
+    void setElements(std::uint64_t _elements) noexcept { mElements = _elements; }
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+// COMPLEX_PERF_REGION(name, elements) marks a parallel chunk of a library kernel as a PerfRegion (see ComplexPerf.h)
+// if COMPLEX_ENABLE_PERF is defined and expands to nothing otherwise, so kernels only depend on ComplexPerf.h in
+// instrumented builds. The definition changes the bodies of inline kernel templates, so COMPLEX_ENABLE_PERF must be
+// set for the whole program (a target wide compile definition), never for single translation units.
+
+#if defined(COMPLEX_ENABLE_PERF)
+#include "ComplexPerf.h"
+
+#define COMPLEX_PERF_CONCAT_IMPL(a, b) a##b
+#define COMPLEX_PERF_CONCAT(a, b) COMPLEX_PERF_CONCAT_IMPL(a, b)
+#define COMPLEX_PERF_REGION(name, elements) const PerfRegion COMPLEX_PERF_CONCAT(tPerfRegion, __LINE__)(name, elements)
+#else
+#define COMPLEX_PERF_REGION(name, elements)
+#endif
@@ -0,0 +1,582 @@
+#pragma once
+
+#include <coroutine>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+#include "ComplexMemory.h"
+#include "ComplexParallel.h"
+
+// Coroutine based streaming pipeline over blocks of complex samples.
+// Every stage is a coroutine that awaits blocks from a bounded channel, processes them and awaits the hand-off to
+// the next channel. A full channel suspends its producer (back-pressure), an empty one its consumer, and suspended
+// coroutines never occupy a thread: the PipelineScheduler's workers only run stages that can make progress, so
+// consecutive stages work on different blocks on different cores. Blocks are moved between stages (only the plane
+// pointers change hands) and the sink returns them to a pool the source refills, so the steady state does not allocate.
+// Each stage runs on at most one thread at a time and sees the blocks in stream order.
+
+// Thread pool resuming coroutine handles in FIFO order.
+class PipelineScheduler
+{
+private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::coroutine_handle<>> mQueue;
+    std::vector<std::thread> mWorkers;
+    bool mStop = false;
+
+    void work() noexcept
+    {
+        for (;;)
+        {
+            std::coroutine_handle<> tHandle;
+            {
+                std::unique_lock tLock(mMutex);
+                mCondition.wait(tLock, [this]() noexcept
+                                { return mStop || !mQueue.empty(); });
+                if (mQueue.empty())
+                    return;
+                tHandle = mQueue.front();
+                mQueue.pop_front();
+            }
+            tHandle.resume();
+        }
+    }
+
+public:
+    // 0 threads selects one worker per hardware thread.
+    explicit PipelineScheduler(std::size_t _threads = 0) noexcept(false)
+    {
+        const std::size_t tThreads = complexThreadCount(_threads);
+        mWorkers.reserve(tThreads);
+        for (std::size_t i = 0; i < tThreads; ++i)
+            mWorkers.emplace_back([this]() noexcept
+                                  { work(); });
+    }
+    PipelineScheduler(const PipelineScheduler &) = delete;
+    PipelineScheduler &operator=(const PipelineScheduler &) = delete;
+    // Resumes the handles still queued, then joins the workers.
+    ~PipelineScheduler()
+    {
+        {
+            std::lock_guard tLock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        for (auto &tWorker : mWorkers)
+            tWorker.join();
+    }
+
+    [[nodiscard]] std::size_t getThreadCount() const noexcept { return mWorkers.size(); }
+
+    void schedule(std::coroutine_handle<> _handle) noexcept(false)
+    {
+        {
+            std::lock_guard tLock(mMutex);
+            mQueue.push_back(_handle);
+        }
+        mCondition.notify_one();
+    }
+};
+
+// Fire and forget coroutine for pipeline stages. The coroutine starts suspended, is started with start() and reports
+// its completion (and a possibly escaped exception) to the callback set with onDone(). The owner destroys the frame.
+class PipelineTask
+{
+public:
+    struct promise_type
+    {
+        std::function<void(std::exception_ptr)> mOnDone;
+        std::exception_ptr mException;
+
+        struct FinalAwaiter
+        {
+            [[nodiscard]] bool await_ready() const noexcept { return false; }
+            // The frame may be destroyed as soon as the callback signalled completion, so nothing of it is touched afterwards.
+            void await_suspend(std::coroutine_handle<promise_type> _handle) noexcept
+            {
+                auto tOnDone = std::move(_handle.promise().mOnDone);
+                const auto tException = _handle.promise().mException;
+                if (tOnDone)
+                    tOnDone(tException);
+            }
+            void await_resume() const noexcept {}
+        };
+
+        [[nodiscard]] PipelineTask get_return_object() noexcept { return PipelineTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+        [[nodiscard]] FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { mException = std::current_exception(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> mHandle;
+
+    explicit PipelineTask(std::coroutine_handle<promise_type> _handle) noexcept : mHandle(_handle) {}
+
+public:
+    PipelineTask(PipelineTask &&_other) noexcept : mHandle(std::exchange(_other.mHandle, {})) {}
+    PipelineTask &operator=(PipelineTask &&_other) noexcept
+    {
+        if (this != &_other)
+        {
+            if (mHandle)
+                mHandle.destroy();
+            mHandle = std::exchange(_other.mHandle, {});
+        }
+        return *this;
+    }
+    PipelineTask(const PipelineTask &) = delete;
+    PipelineTask &operator=(const PipelineTask &) = delete;
+    // Must not be destroyed while the coroutine runs.
+    ~PipelineTask()
+    {
+        if (mHandle)
+            mHandle.destroy();
+    }
+
+    void onDone(std::function<void(std::exception_ptr)> _onDone) noexcept { mHandle.promise().mOnDone = std::move(_onDone); }
+    void start(PipelineScheduler &_scheduler) noexcept(false) { _scheduler.schedule(mHandle); }
+};
+
+// Bounded multi producer / multi consumer channel with awaitable push and pop.
+// Values are handed directly to a waiting consumer when there is one. Suspended coroutines are resumed on the scheduler.
+// After close() pushes fail and pops drain the buffered values, then return std::nullopt.
+template <class V>
+class BoundedChannel
+{
+private:
+    struct PushWaiter
+    {
+        std::coroutine_handle<> handle;
+        V *value;
+        bool *accepted;
+    };
+    struct PopWaiter
+    {
+        std::coroutine_handle<> handle;
+        std::optional<V> *slot;
+    };
+
+    PipelineScheduler &mScheduler;
+    std::size_t mCapacity;
+    std::mutex mMutex;
+    std::deque<V> mBuffer;
+    std::deque<PushWaiter> mPushers;
+    std::deque<PopWaiter> mPoppers;
+    bool mClosed = false;
+
+public:
+    class PushAwaiter
+    {
+    private:
+        BoundedChannel &mChannel;
+        V mValue;
+        bool mAccepted = false;
+
+    public:
+        PushAwaiter(BoundedChannel &_channel, V &&_value) noexcept(std::is_nothrow_move_constructible_v<V>) : mChannel(_channel), mValue(std::move(_value)) {}
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        [[nodiscard]] bool await_suspend(std::coroutine_handle<> _handle) noexcept(false)
+        {
+            std::unique_lock tLock(mChannel.mMutex);
+            if (mChannel.mClosed)
+                return false;
+            if (!mChannel.mPoppers.empty())
+            {
+                const PopWaiter tWaiter = mChannel.mPoppers.front();
+                mChannel.mPoppers.pop_front();
+                tWaiter.slot->emplace(std::move(mValue));
+                mAccepted = true;
+                tLock.unlock();
+                mChannel.mScheduler.schedule(tWaiter.handle);
+                return false;
+            }
+            if (mChannel.mBuffer.size() < mChannel.mCapacity)
+            {
+                mChannel.mBuffer.push_back(std::move(mValue));
+                mAccepted = true;
+                return false;
+            }
+            mChannel.mPushers.push_back({_handle, &mValue, &mAccepted});
+            return true;
+        }
+        // false if the channel was closed before the value was accepted.
+        [[nodiscard]] bool await_resume() const noexcept { return mAccepted; }
+    };
+
+    class PopAwaiter
+    {
+    private:
+        BoundedChannel &mChannel;
+        std::optional<V> mResult;
+
+    public:
+        explicit PopAwaiter(BoundedChannel &_channel) noexcept : mChannel(_channel) {}
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+        [[nodiscard]] bool await_suspend(std::coroutine_handle<> _handle) noexcept(false)
+        {
+            std::unique_lock tLock(mChannel.mMutex);
+            if (!mChannel.mBuffer.empty())
+            {
+                mResult.emplace(std::move(mChannel.mBuffer.front()));
+                mChannel.mBuffer.pop_front();
+                if (!mChannel.mPushers.empty())
+                {
+                    const PushWaiter tWaiter = mChannel.mPushers.front();
+                    mChannel.mPushers.pop_front();
+                    mChannel.mBuffer.push_back(std::move(*tWaiter.value));
+                    *tWaiter.accepted = true;
+                    tLock.unlock();
+                    mChannel.mScheduler.schedule(tWaiter.handle);
+                }
+                return false;
+            }
+            if (mChannel.mClosed)
+                return false;
+            mChannel.mPoppers.push_back({_handle, &mResult});
+            return true;
+        }
+        // std::nullopt once the channel is closed and drained.
+        [[nodiscard]] std::optional<V> await_resume() noexcept(std::is_nothrow_move_constructible_v<V>) { return std::move(mResult); }
+    };
+
+    BoundedChannel(PipelineScheduler &_scheduler, std::size_t _capacity) noexcept(false)
+        : mScheduler(_scheduler), mCapacity(_capacity)
+    {
+        if (_capacity == 0)
+            throw std::invalid_argument("BoundedChannel: capacity must be at least 1");
+    }
+    BoundedChannel(const BoundedChannel &) = delete;
+    BoundedChannel &operator=(const BoundedChannel &) = delete;
+
+    [[nodiscard]] std::size_t getCapacity() const noexcept { return mCapacity; }
+
+    [[nodiscard]] PushAwaiter push(V _value) noexcept(std::is_nothrow_move_constructible_v<V>) { return PushAwaiter(*this, std::move(_value)); }
+    [[nodiscard]] PopAwaiter pop() noexcept { return PopAwaiter(*this); }
+
+    // Wakes every waiting coroutine, waiting pushes fail and waiting pops return std::nullopt.
+    void close() noexcept(false)
+    {
+        std::deque<PushWaiter> tPushers;
+        std::deque<PopWaiter> tPoppers;
+        {
+            std::lock_guard tLock(mMutex);
+            mClosed = true;
+            tPushers.swap(mPushers);
+            tPoppers.swap(mPoppers);
+        }
+        for (const auto &tWaiter : tPushers)
+            mScheduler.schedule(tWaiter.handle);
+        for (const auto &tWaiter : tPoppers)
+            mScheduler.schedule(tWaiter.handle);
+    }
+};
+
+// Unit of hand-off between stages, sequence is the position of the block in the stream.
+template <typename T>
+struct ComplexBlock
+{
+    std::size_t sequence = 0;
+    PmrComplexBuffer<T> data;
+};
+
+struct PipelineStageMetrics
+{
+    std::string name;
+    std::size_t blocks = 0;
+    std::size_t samples = 0;
+    // Time spent in the stage function.
+    double busySeconds = 0;
+    // Time suspended waiting for an input block (starvation) and for room downstream (back-pressure).
+    double inputWaitSeconds = 0;
+    double outputWaitSeconds = 0;
+    // Slowest single call of the stage function.
+    double maxBlockSeconds = 0;
+
+    // Samples per busy second, the rate the stage could sustain on its own.
+    [[nodiscard]] double throughput() const noexcept { return busySeconds > 0 ? static_cast<double>(samples) / busySeconds : 0; }
+    // Mean busy seconds per block.
+    [[nodiscard]] double latency() const noexcept { return blocks != 0 ? busySeconds / static_cast<double>(blocks) : 0; }
+};
+
+// Linear pipeline: one source, any number of in-place stages, one sink.
+//   source(name, bool(ComplexBlock<T> &))       fills a block (may resize it), false ends the stream
+//   stage(name, void(ComplexBlock<T> &))        transforms a block in place
+//   sink(name, void(const ComplexBlock<T> &))   consumes a block
+// run() blocks until the stream is exhausted. If a stage throws, all channels are closed, the remaining stages wind
+// down and run() rethrows the first exception.
+template <typename T>
+class ComplexPipeline
+{
+public:
+    using Block = ComplexBlock<T>;
+
+private:
+    enum class StageKind
+    {
+        Source,
+        Transform,
+        Sink
+    };
+    struct Stage
+    {
+        std::string name;
+        StageKind kind;
+        std::function<bool(Block &)> source;
+        std::function<void(Block &)> transform;
+        std::function<void(const Block &)> sink;
+    };
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t mBlockSize;
+    std::size_t mCapacity;
+    std::size_t mThreads;
+    std::pmr::memory_resource *mResource;
+    std::vector<Stage> mStages;
+    std::vector<PipelineStageMetrics> mMetrics;
+    double mWallSeconds = 0;
+
+    std::mutex mPoolMutex;
+    std::vector<Block> mPool;
+    std::size_t mAllocatedBlocks = 0;
+
+    [[nodiscard]] static double elapsed(Clock::time_point _start) noexcept
+    {
+        return std::chrono::duration<double>(Clock::now() - _start).count();
+    }
+    static void addBusy(PipelineStageMetrics &_metrics, Clock::time_point _start) noexcept
+    {
+        const double tSeconds = elapsed(_start);
+        _metrics.busySeconds += tSeconds;
+        _metrics.maxBlockSeconds = std::max(_metrics.maxBlockSeconds, tSeconds);
+    }
+
+    [[nodiscard]] Block acquireBlock() noexcept(false)
+    {
+        {
+            std::lock_guard tLock(mPoolMutex);
+            if (!mPool.empty())
+            {
+                Block tBlock = std::move(mPool.back());
+                mPool.pop_back();
+                tBlock.data.resize(mBlockSize);
+                return tBlock;
+            }
+            ++mAllocatedBlocks;
+        }
+        return Block{0, PmrComplexBuffer<T>(mBlockSize, std::pmr::polymorphic_allocator<T>(mResource))};
+    }
+    void releaseBlock(Block &&_block) noexcept(false)
+    {
+        std::lock_guard tLock(mPoolMutex);
+        mPool.push_back(std::move(_block));
+    }
+
+    PipelineTask runSource(std::size_t _index, BoundedChannel<Block> &_out)
+    {
+        const Stage &tStage = mStages[_index];
+        PipelineStageMetrics &tMetrics = mMetrics[_index];
+        for (std::size_t tSequence = 0;; ++tSequence)
+        {
+            Block tBlock = acquireBlock();
+            tBlock.sequence = tSequence;
+            const auto tStart = Clock::now();
+            const bool tMore = tStage.source(tBlock);
+            addBusy(tMetrics, tStart);
+            if (!tMore)
+            {
+                releaseBlock(std::move(tBlock));
+                break;
+            }
+            ++tMetrics.blocks;
+            tMetrics.samples += tBlock.data.size();
+
+            const auto tWait = Clock::now();
+            const bool tAccepted = co_await _out.push(std::move(tBlock));
+            tMetrics.outputWaitSeconds += elapsed(tWait);
+            if (!tAccepted)
+                break;
+        }
+        _out.close();
+    }
+
+    PipelineTask runTransform(std::size_t _index, BoundedChannel<Block> &_in, BoundedChannel<Block> &_out)
+    {
+        const Stage &tStage = mStages[_index];
+        PipelineStageMetrics &tMetrics = mMetrics[_index];
+        for (;;)
+        {
+            const auto tInputWait = Clock::now();
+            std::optional<Block> tBlock = co_await _in.pop();
+            tMetrics.inputWaitSeconds += elapsed(tInputWait);
+            if (!tBlock)
+                break;
+
+            const auto tStart = Clock::now();
+            tStage.transform(*tBlock);
+            addBusy(tMetrics, tStart);
+            ++tMetrics.blocks;
+            tMetrics.samples += tBlock->data.size();
+
+            const auto tOutputWait = Clock::now();
+            const bool tAccepted = co_await _out.push(std::move(*tBlock));
+            tMetrics.outputWaitSeconds += elapsed(tOutputWait);
+            if (!tAccepted)
+                break;
+        }
+        _out.close();
+        _in.close();
+    }
+
+    PipelineTask runSink(std::size_t _index, BoundedChannel<Block> &_in)
+    {
+        const Stage &tStage = mStages[_index];
+        PipelineStageMetrics &tMetrics = mMetrics[_index];
+        for (;;)
+        {
+            const auto tInputWait = Clock::now();
+            std::optional<Block> tBlock = co_await _in.pop();
+            tMetrics.inputWaitSeconds += elapsed(tInputWait);
+            if (!tBlock)
+                break;
+
+            const auto tStart = Clock::now();
+            tStage.sink(*tBlock);
+            addBusy(tMetrics, tStart);
+            ++tMetrics.blocks;
+            tMetrics.samples += tBlock->data.size();
+            releaseBlock(std::move(*tBlock));
+        }
+        _in.close();
+    }
+
+    ComplexPipeline &addStage(Stage &&_stage) noexcept(false)
+    {
+        if (!mStages.empty() && mStages.back().kind == StageKind::Sink)
+            throw std::invalid_argument("ComplexPipeline: no stage can follow the sink");
+        if ((_stage.kind == StageKind::Source) != mStages.empty())
+            throw std::invalid_argument("ComplexPipeline: the source must be the first and only source stage");
+        mStages.push_back(std::move(_stage));
+        return *this;
+    }
+
+public:
+    // _capacity blocks can be buffered between two consecutive stages, 0 threads selects one worker per hardware thread.
+    explicit ComplexPipeline(std::size_t _blockSize, std::size_t _capacity = 4, std::size_t _threads = 0, std::pmr::memory_resource *_resource = std::pmr::get_default_resource()) noexcept(false)
+        : mBlockSize(_blockSize), mCapacity(_capacity), mThreads(_threads), mResource(_resource)
+    {
+        if (_blockSize == 0)
+            throw std::invalid_argument("ComplexPipeline: block size must be at least 1");
+        if (_capacity == 0)
+            throw std::invalid_argument("ComplexPipeline: capacity must be at least 1");
+    }
+    ComplexPipeline(const ComplexPipeline &) = delete;
+    ComplexPipeline &operator=(const ComplexPipeline &) = delete;
+
+    template <class F>
+    ComplexPipeline &source(std::string _name, F &&_function) noexcept(false)
+    {
+        return addStage(Stage{std::move(_name), StageKind::Source, std::forward<F>(_function), {}, {}});
+    }
+    template <class F>
+    ComplexPipeline &stage(std::string _name, F &&_function) noexcept(false)
+    {
+        return addStage(Stage{std::move(_name), StageKind::Transform, {}, std::forward<F>(_function), {}});
+    }
+    template <class F>
+    ComplexPipeline &sink(std::string _name, F &&_function) noexcept(false)
+    {
+        return addStage(Stage{std::move(_name), StageKind::Sink, {}, {}, std::forward<F>(_function)});
+    }
+
+    [[nodiscard]] std::size_t getStageCount() const noexcept { return mStages.size(); }
+    [[nodiscard]] std::size_t getBlockSize() const noexcept { return mBlockSize; }
+    // Blocks allocated so far, bounded by the buffering and not by the stream length.
+    [[nodiscard]] std::size_t getAllocatedBlocks() const noexcept { return mAllocatedBlocks; }
+
+    // Metrics of the last run, in stage order.
+    [[nodiscard]] const std::vector<PipelineStageMetrics> &getMetrics() const noexcept { return mMetrics; }
+    [[nodiscard]] double getWallSeconds() const noexcept { return mWallSeconds; }
+    // The stage with the most busy time limits the throughput of the whole pipeline.
+    [[nodiscard]] std::size_t getBottleneck() const noexcept
+    {
+        const auto tMax = std::max_element(mMetrics.begin(), mMetrics.end(), [](const PipelineStageMetrics &_lh, const PipelineStageMetrics &_rh) noexcept
+                                           { return _lh.busySeconds < _rh.busySeconds; });
+        return static_cast<std::size_t>(tMax - mMetrics.begin());
+    }
+
+    void run() noexcept(false)
+    {
+        if (mStages.size() < 2 || mStages.back().kind != StageKind::Sink)
+            throw std::invalid_argument("ComplexPipeline: needs a source and a sink");
+
+        mMetrics.assign(mStages.size(), PipelineStageMetrics{});
+        for (std::size_t i = 0; i < mStages.size(); ++i)
+            mMetrics[i].name = mStages[i].name;
+
+        const auto tStart = Clock::now();
+        std::vector<std::unique_ptr<BoundedChannel<Block>>> tChannels;
+        std::vector<PipelineTask> tTasks;
+        std::mutex tDoneMutex;
+        std::condition_variable tDoneCondition;
+        std::size_t tRemaining = mStages.size();
+        std::exception_ptr tException;
+        // Inner scope: the workers are joined before the channels and coroutine frames are destroyed.
+        {
+            PipelineScheduler tScheduler(std::min(complexThreadCount(mThreads), mStages.size()));
+            for (std::size_t i = 0; i + 1 < mStages.size(); ++i)
+                tChannels.push_back(std::make_unique<BoundedChannel<Block>>(tScheduler, mCapacity));
+
+            tTasks.push_back(runSource(0, *tChannels.front()));
+            for (std::size_t i = 1; i + 1 < mStages.size(); ++i)
+                tTasks.push_back(runTransform(i, *tChannels[i - 1], *tChannels[i]));
+            tTasks.push_back(runSink(mStages.size() - 1, *tChannels.back()));
+
+            for (auto &tTask : tTasks)
+                tTask.onDone([&](std::exception_ptr _exception)
+                             {
+                    if (_exception)
+                    {
+                        {
+                            std::lock_guard tLock(tDoneMutex);
+                            if (!tException)
+                                tException = _exception;
+                        }
+                        for (auto &tChannel : tChannels)
+                            tChannel->close();
+                    }
+                    std::lock_guard tLock(tDoneMutex);
+                    --tRemaining;
+                    tDoneCondition.notify_all(); });
+            for (auto &tTask : tTasks)
+                tTask.start(tScheduler);
+
+            std::unique_lock tLock(tDoneMutex);
+            tDoneCondition.wait(tLock, [&]() noexcept
+                                { return tRemaining == 0; });
+        }
+        tTasks.clear();
+        mWallSeconds = elapsed(tStart);
+
+        if (tException)
+            std::rethrow_exception(tException);
+    }
+};
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Polynomials over complex numbers. Coefficients are given in ascending order,
+// p(z) = c[0] + c[1] z + ... + c[n] z^n.
+// All kernels run Horner's scheme on plain real/imaginary parts; a Complex is only constructed for the
+// final results, so abs and phi are not recomputed at every step.
+
+// Evaluates p at a single point.
+template <typename T, class SIN, class COS, class POW2, class SQRT, class ATAN>
+[[nodiscard]] constexpr Complex<T, SIN, COS, POW2, SQRT, ATAN> evaluatePolynomial(std::span<const std::type_identity_t<Complex<T, SIN, COS, POW2, SQRT, ATAN>>> _coefficients, const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_z) noexcept(std::is_nothrow_constructible_v<T>)
+{
+    T tRe = 0;
+    T tImg = 0;
+    for (std::size_t k = _coefficients.size(); k-- > 0;)
+    {
+        const T tNextRe = tRe * _z.getReal() - tImg * _z.getImaginary() + _coefficients[k].getReal();
+        tImg = tRe * _z.getImaginary() + tImg * _z.getReal() + _coefficients[k].getImaginary();
+        tRe = tNextRe;
+    }
+    return Complex<T, SIN, COS, POW2, SQRT, ATAN>(tRe, tImg);
+}
+
+// Evaluates p at all _points. Points are processed in tiles with the tile loop innermost, so every
+// Horner step is one vectorizable loop across points; tiles are distributed over _threads threads (0: all hardware threads).
+template <ComplexReadableView COEFFICIENTS, ComplexReadableView POINTS, ComplexWritableView OUT>
+void evaluatePolynomial(const COEFFICIENTS &_coefficients, const POINTS &_points, const OUT &_out, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename OUT::value_type;
+    constexpr std::size_t kTile = 64;
+
+    if (_out.size() != _points.size())
+        throw std::invalid_argument("evaluatePolynomial: output and points must have the same size");
+
+    const std::size_t tTiles = (_points.size() + kTile - 1) / kTile;
+    complexParallelFor(tTiles, _threads, [&](std::size_t _begin, std::size_t _end) noexcept
+                       {
+        COMPLEX_PERF_REGION("evaluatePolynomial", std::min(_points.size(), _end * kTile) - _begin * kTile);
+        T tZRe[kTile];
+        T tZImg[kTile];
+        T tRe[kTile];
+        T tImg[kTile];
+        for (std::size_t tTile = _begin; tTile < _end; ++tTile)
+        {
+            const std::size_t tFirst = tTile * kTile;
+            const std::size_t tCount = std::min(kTile, _points.size() - tFirst);
+            for (std::size_t l = 0; l < tCount; ++l)
+            {
+                tZRe[l] = _points.real(tFirst + l);
+                tZImg[l] = _points.imag(tFirst + l);
+                tRe[l] = 0;
+                tImg[l] = 0;
+            }
+            for (std::size_t k = _coefficients.size(); k-- > 0;)
+            {
+                const T tCRe = _coefficients.real(k);
+                const T tCImg = _coefficients.imag(k);
+                for (std::size_t l = 0; l < tCount; ++l)
+                {
+                    const T tNextRe = tRe[l] * tZRe[l] - tImg[l] * tZImg[l] + tCRe;
+                    tImg[l] = tRe[l] * tZImg[l] + tImg[l] * tZRe[l] + tCImg;
+                    tRe[l] = tNextRe;
+                }
+            }
+            for (std::size_t l = 0; l < tCount; ++l)
+                _out.set(tFirst + l, tRe[l], tImg[l]);
+        } });
+}
+
+// Simultaneous root finder (Aberth-Ehrlich iteration, a cubically converging refinement of Durand-Kerner).
+// All roots are updated from the previous iterate (Jacobi style), so the per-root updates run in parallel and the
+// result is bit-identical for every thread count. A root is frozen once its correction falls below
+// _tolerance relative to its magnitude; the iteration stops when all roots are frozen or after _maxIterations.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>, class POW2 = default_pow2<T>, class SQRT = default_sqrt<T>, class ATAN = default_atan<T>>
+class PolynomialRootFinder
+{
+public:
+    using ComplexType = Complex<T, SIN, COS, POW2, SQRT, ATAN>;
+
+    struct Result
+    {
+        std::vector<ComplexType> roots;
+        std::size_t iterations = 0;
+        bool converged = false;
+    };
+
+private:
+    // Spawning threads only pays off if every thread gets enough roots.
+    static constexpr std::size_t kMinRootsPerThread = 64;
+
+    T mTolerance;
+    std::size_t mMaxIterations;
+    std::size_t mThreads;
+    SIN mSin;
+    COS mCos;
+
+    // _out = _num / _den with Smith's scaling, which neither squares nor overflows the denominator.
+    // False if _den is 0 or the quotient is not finite.
+    static bool divide(T _numRe, T _numImg, T _denRe, T _denImg, T &_outRe, T &_outImg) noexcept
+    {
+        if (std::abs(_denRe) >= std::abs(_denImg))
+        {
+            if (_denRe == 0)
+                return false;
+            const T tRatio = _denImg / _denRe;
+            const T tScale = _denRe + _denImg * tRatio;
+            _outRe = (_numRe + _numImg * tRatio) / tScale;
+            _outImg = (_numImg - _numRe * tRatio) / tScale;
+        }
+        else
+        {
+            const T tRatio = _denRe / _denImg;
+            const T tScale = _denRe * tRatio + _denImg;
+            _outRe = (_numRe * tRatio + _numImg) / tScale;
+            _outImg = (_numImg * tRatio - _numRe) / tScale;
+        }
+        return std::isfinite(_outRe) && std::isfinite(_outImg);
+    }
+
+public:
+    explicit PolynomialRootFinder(T _tolerance = 16 * std::numeric_limits<T>::epsilon(), std::size_t _maxIterations = 500, std::size_t _threads = 0) noexcept
+        : mTolerance(_tolerance), mMaxIterations(_maxIterations), mThreads(complexThreadCount(_threads))
+    {
+    }
+
+    template <ComplexReadableView IN>
+    [[nodiscard]] Result solve(const IN &_coefficients) const noexcept(false)
+    {
+        Result tResult;
+        if (_coefficients.size() == 0)
+            throw std::invalid_argument("PolynomialRootFinder: no coefficients");
+        const std::size_t tDegree = _coefficients.size() - 1;
+        const T tLeadRe = _coefficients.real(tDegree);
+        const T tLeadImg = _coefficients.imag(tDegree);
+        const T tLeadNorm = tLeadRe * tLeadRe + tLeadImg * tLeadImg;
+        if (tLeadNorm == 0)
+            throw std::invalid_argument("PolynomialRootFinder: leading coefficient must not be 0");
+        if (tDegree == 0)
+        {
+            tResult.converged = true;
+            return tResult;
+        }
+
+        // Start on a circle enclosing all roots (Fujiwara bound), rotated off the real axis to break symmetries.
+        T tRadius = 0;
+        for (std::size_t k = 0; k < tDegree; ++k)
+        {
+            const T tNorm = (_coefficients.real(k) * _coefficients.real(k) + _coefficients.imag(k) * _coefficients.imag(k)) / tLeadNorm;
+            const T tScale = k == 0 ? T(0.25) : T(1);
+            tRadius = std::max(tRadius, static_cast<T>(std::pow(tScale * tNorm, T(1) / static_cast<T>(2 * (tDegree - k)))));
+        }
+        tRadius = tRadius == 0 ? T(1) : 2 * tRadius;
+
+        std::vector<T> tRe(tDegree);
+        std::vector<T> tImg(tDegree);
+        std::vector<T> tNextRe(tDegree);
+        std::vector<T> tNextImg(tDegree);
+        std::vector<char> tFrozen(tDegree, 0);
+        for (std::size_t i = 0; i < tDegree; ++i)
+        {
+            const T tAngle = static_cast<T>(2 * std::numbers::pi_v<T> * static_cast<T>(i) / static_cast<T>(tDegree) + T(0.4));
+            tRe[i] = tRadius * mCos(tAngle);
+            tImg[i] = tRadius * mSin(tAngle);
+        }
+
+        for (tResult.iterations = 0; tResult.iterations < mMaxIterations; ++tResult.iterations)
+        {
+            complexParallelFor(tDegree, mThreads, [&](std::size_t _begin, std::size_t _end) noexcept
+                               {
+                for (std::size_t i = _begin; i < _end; ++i)
+                {
+                    tNextRe[i] = tRe[i];
+                    tNextImg[i] = tImg[i];
+                    if (tFrozen[i])
+                        continue;
+
+                    // p(z) and p'(z) by Horner's scheme
+                    T tPRe = tLeadRe;
+                    T tPImg = tLeadImg;
+                    T tDRe = 0;
+                    T tDImg = 0;
+                    for (std::size_t k = tDegree; k-- > 0;)
+                    {
+                        const T tDNextRe = tDRe * tRe[i] - tDImg * tImg[i] + tPRe;
+                        tDImg = tDRe * tImg[i] + tDImg * tRe[i] + tPImg;
+                        tDRe = tDNextRe;
+                        const T tPNextRe = tPRe * tRe[i] - tPImg * tImg[i] + _coefficients.real(k);
+                        tPImg = tPRe * tImg[i] + tPImg * tRe[i] + _coefficients.imag(k);
+                        tPRe = tPNextRe;
+                    }
+                    if (tPRe == 0 && tPImg == 0)
+                    {
+                        tFrozen[i] = 1;
+                        continue;
+                    }
+
+                    // S = sum 1 / (z_i - z_j); coincident estimates leave S undefined.
+                    T tSRe = 0;
+                    T tSImg = 0;
+                    bool tDefined = true;
+                    for (std::size_t j = 0; j < tDegree && tDefined; ++j)
+                    {
+                        if (j == i)
+                            continue;
+                        T tInverseRe;
+                        T tInverseImg;
+                        tDefined = divide(T(1), T(0), tRe[i] - tRe[j], tImg[i] - tImg[j], tInverseRe, tInverseImg);
+                        tSRe += tInverseRe;
+                        tSImg += tInverseImg;
+                    }
+
+                    // w = N / (1 - N * S) with the Newton ratio N = p / p', evaluated as p / (p' - p * S),
+                    // which stays defined where p' vanishes.
+                    T tWRe = 0;
+                    T tWImg = 0;
+                    if (tDefined)
+                        tDefined = divide(tPRe, tPImg, tDRe - (tPRe * tSRe - tPImg * tSImg), tDImg - (tPRe * tSImg + tPImg * tSRe), tWRe, tWImg);
+                    if (!tDefined)
+                    {
+                        // Two estimates met or the denominator vanished: nudge the estimate in an index dependent
+                        // direction, relative to the scale of the roots, and retry in the next iteration.
+                        const T tNudge = std::sqrt(std::numeric_limits<T>::epsilon()) * std::max(tRadius, std::hypot(tRe[i], tImg[i]));
+                        tNextRe[i] = tRe[i] + tNudge * mCos(static_cast<T>(i + 1));
+                        tNextImg[i] = tImg[i] + tNudge * mSin(static_cast<T>(i + 1));
+                        continue;
+                    }
+                    tNextRe[i] = tRe[i] - tWRe;
+                    tNextImg[i] = tImg[i] - tWImg;
+
+                    // Relative to |z| also for tiny roots, hypot keeps both sides from underflowing.
+                    const T tMagnitude = std::max(std::hypot(tNextRe[i], tNextImg[i]), std::numeric_limits<T>::min());
+                    if (std::hypot(tWRe, tWImg) <= mTolerance * tMagnitude)
+                        tFrozen[i] = 1;
+                } }, kMinRootsPerThread);
+            tRe.swap(tNextRe);
+            tImg.swap(tNextImg);
+
+            if (std::all_of(tFrozen.begin(), tFrozen.end(), [](char _frozen) noexcept { return _frozen != 0; }))
+            {
+                tResult.converged = true;
+                ++tResult.iterations;
+                break;
+            }
+        }
+
+        tResult.roots.reserve(tDegree);
+        for (std::size_t i = 0; i < tDegree; ++i)
+            tResult.roots.emplace_back(tRe[i], tImg[i]);
+        return tResult;
+    }
+};
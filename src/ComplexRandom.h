@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Counter-based random complex samples.
+// PhiloxStream implements Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"): the random
+// block for sample i is a pure function of (seed, stream, i), so any part of a sequence can be generated independently.
+// The generators below therefore produce bit-identical buffers for every thread count, and giving every
+// simulation thread or channel its own stream id yields reproducible, non-overlapping sequences.
+
+class PhiloxStream
+{
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+private:
+    static constexpr std::uint32_t kMultiplier0 = 0xD2511F53;
+    static constexpr std::uint32_t kMultiplier1 = 0xCD9E8D57;
+    static constexpr std::uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr std::uint32_t kWeyl1 = 0xBB67AE85;
+
+    std::uint64_t mSeed = 0;
+    std::uint64_t mStream = 0;
+    std::uint64_t mPosition = 0;
+
+public:
+    constexpr explicit PhiloxStream(std::uint64_t _seed, std::uint64_t _stream = 0) noexcept
+        : mSeed(_seed), mStream(_stream)
+    {
+    }
+
+    [[nodiscard]] static constexpr Block generate(Block _counter, std::array<std::uint32_t, 2> _key) noexcept
+    {
+        for (int tRound = 0; tRound < 10; ++tRound)
+        {
+            const std::uint64_t tProduct0 = std::uint64_t{kMultiplier0} * _counter[0];
+            const std::uint64_t tProduct1 = std::uint64_t{kMultiplier1} * _counter[2];
+            _counter = {static_cast<std::uint32_t>(tProduct1 >> 32) ^ _counter[1] ^ _key[0], static_cast<std::uint32_t>(tProduct1),
+                        static_cast<std::uint32_t>(tProduct0 >> 32) ^ _counter[3] ^ _key[1], static_cast<std::uint32_t>(tProduct0)};
+            _key[0] += kWeyl0;
+            _key[1] += kWeyl1;
+        }
+        return _counter;
+    }
+
+    // Random block number _index of this stream (independent of the current position).
+    [[nodiscard]] constexpr Block operator()(std::uint64_t _index) const noexcept
+    {
+        return generate({static_cast<std::uint32_t>(_index), static_cast<std::uint32_t>(_index >> 32), static_cast<std::uint32_t>(mStream), static_cast<std::uint32_t>(mStream >> 32)},
+                        {static_cast<std::uint32_t>(mSeed), static_cast<std::uint32_t>(mSeed >> 32)});
+    }
+
+    [[nodiscard]] constexpr std::uint64_t getSeed() const noexcept { return mSeed; }
+    [[nodiscard]] constexpr std::uint64_t getStream() const noexcept { return mStream; }
+    [[nodiscard]] constexpr std::uint64_t getPosition() const noexcept { return mPosition; }
+    constexpr PhiloxStream &setPosition(std::uint64_t _position) noexcept
+    {
+        mPosition = _position;
+        return *this;
+    }
+    constexpr PhiloxStream &skip(std::uint64_t _count) noexcept
+    {
+        mPosition += _count;
+        return *this;
+    }
+    // Independent stream with the same seed, e.g. one per worker thread.
+    [[nodiscard]] constexpr PhiloxStream substream(std::uint64_t _stream) const noexcept
+    {
+        return PhiloxStream(mSeed, _stream);
+    }
+};
+
+// Calls _sample(index, u1, u2) for the next _size positions of _stream with u1 uniform in (0, 1] and u2 uniform in [0, 1),
+// both with 53 random bits, and advances the stream. Chunks run on _threads threads (0: all hardware threads).
+template <typename T, class SAMPLE>
+void philoxUniformPairs(PhiloxStream &_stream, std::size_t _size, std::size_t _threads, const SAMPLE &_sample) noexcept(false)
+{
+    constexpr std::size_t kChunk = 256;
+    constexpr double kScale = 1.0 / 9007199254740992.0; // 2^-53
+
+    const std::uint64_t tStart = _stream.getPosition();
+    const std::size_t tChunks = (_size + kChunk - 1) / kChunk;
+    complexParallelFor(tChunks, _threads, [&](std::size_t _begin, std::size_t _end)
+                       {
+        COMPLEX_PERF_REGION("random", std::min(_size, _end * kChunk) - _begin * kChunk);
+        T tU1[kChunk];
+        T tU2[kChunk];
+        for (std::size_t tChunk = _begin; tChunk < _end; ++tChunk)
+        {
+            const std::size_t tFirst = tChunk * kChunk;
+            const std::size_t tCount = std::min(kChunk, _size - tFirst);
+            for (std::size_t l = 0; l < tCount; ++l)
+            {
+                const auto tBlock = _stream(tStart + tFirst + l);
+                const std::uint64_t tBits1 = ((std::uint64_t{tBlock[0]} << 32) | tBlock[1]) >> 11;
+                const std::uint64_t tBits2 = ((std::uint64_t{tBlock[2]} << 32) | tBlock[3]) >> 11;
+                tU1[l] = static_cast<T>(static_cast<double>(tBits1 + 1) * kScale);
+                tU2[l] = static_cast<T>(static_cast<double>(tBits2) * kScale);
+            }
+            for (std::size_t l = 0; l < tCount; ++l)
+                _sample(tFirst + l, tU1[l], tU2[l]);
+        } });
+    _stream.skip(_size);
+}
+
+// Circularly-symmetric complex Gaussian noise CN(0, _variance): E|n|^2 = _variance, _variance / 2 per component.
+// Box-Muller transform on the SIN/COS functors; one stream position per sample.
+template <ComplexWritableView OUT, class SIN = default_sin<typename OUT::value_type>, class COS = default_cos<typename OUT::value_type>>
+void generateComplexGaussian(const OUT &_out, PhiloxStream &_stream, typename OUT::value_type _variance = 1, std::size_t _threads = 0, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    using T = typename OUT::value_type;
+    philoxUniformPairs<T>(_stream, _out.size(), _threads, [&](std::size_t _index, T _u1, T _u2) noexcept
+                          {
+        const T tRadius = std::sqrt(-_variance * std::log(_u1));
+        const T tAngle = 2 * std::numbers::pi_v<T> * _u2;
+        _out.set(_index, tRadius * _cos(tAngle), tRadius * _sin(tAngle)); });
+}
+
+// Phasors of constant _amplitude with uniformly distributed phase.
+template <ComplexWritableView OUT, class SIN = default_sin<typename OUT::value_type>, class COS = default_cos<typename OUT::value_type>>
+void generatePhasors(const OUT &_out, PhiloxStream &_stream, typename OUT::value_type _amplitude = 1, std::size_t _threads = 0, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    using T = typename OUT::value_type;
+    philoxUniformPairs<T>(_stream, _out.size(), _threads, [&](std::size_t _index, T, T _u2) noexcept
+                          {
+        const T tAngle = 2 * std::numbers::pi_v<T> * _u2;
+        _out.set(_index, _amplitude * _cos(tAngle), _amplitude * _sin(tAngle)); });
+}
+
+// Independent flat Rayleigh fading coefficients with E|h|^2 = _meanPower.
+template <ComplexWritableView OUT, class SIN = default_sin<typename OUT::value_type>, class COS = default_cos<typename OUT::value_type>>
+void generateRayleighFading(const OUT &_out, PhiloxStream &_stream, typename OUT::value_type _meanPower = 1, std::size_t _threads = 0, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    generateComplexGaussian(_out, _stream, _meanPower, _threads, _sin, _cos);
+}
+
+// Independent flat Rician fading coefficients with E|h|^2 = _meanPower and Rician factor _kFactor
+// (power of the line of sight component with phase _losPhase over the power of the scattered component).
+template <ComplexWritableView OUT, class SIN = default_sin<typename OUT::value_type>, class COS = default_cos<typename OUT::value_type>>
+void generateRicianFading(const OUT &_out, PhiloxStream &_stream, typename OUT::value_type _kFactor, typename OUT::value_type _meanPower = 1, typename OUT::value_type _losPhase = 0, std::size_t _threads = 0, const SIN &_sin = SIN{}, const COS &_cos = COS{}) noexcept(false)
+{
+    using T = typename OUT::value_type;
+    const T tLosAmplitude = std::sqrt(_meanPower * _kFactor / (_kFactor + 1));
+    const T tLosRe = tLosAmplitude * _cos(_losPhase);
+    const T tLosImg = tLosAmplitude * _sin(_losPhase);
+    const T tScatterPower = _meanPower / (_kFactor + 1);
+    philoxUniformPairs<T>(_stream, _out.size(), _threads, [&](std::size_t _index, T _u1, T _u2) noexcept
+                          {
+        const T tRadius = std::sqrt(-tScatterPower * std::log(_u1));
+        const T tAngle = 2 * std::numbers::pi_v<T> * _u2;
+        _out.set(_index, tLosRe + tRadius * _cos(tAngle), tLosImg + tRadius * _sin(tAngle)); });
+}
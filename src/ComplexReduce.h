@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Deterministic reductions over complex views.
+// The input is cut into leaves of kReduceLeafSize elements, independent of the thread count. Inside a leaf
+// kReduceLanes accumulators take every kReduceLanes-th element (one SIMD register per accumulator set) and are
+// folded pairwise; the leaf results are then combined in a fixed pairwise tree. The order of all floating point
+// operations is therefore fixed, which makes results deterministic and bit-identical for every thread count.
+// Summation is pairwise only above leaf level: every lane still accumulates its kReduceLeafSize / kReduceLanes
+// elements sequentially, so the rounding error grows as O(kReduceLeafSize / kReduceLanes + log n) rather than
+// O(log n). No Complex is constructed before the final result.
+
+constexpr std::size_t kReduceLeafSize = 1024;
+constexpr std::size_t kReduceLanes = 8;
+
+template <typename T>
+struct ComplexSumAccumulator
+{
+    T re = 0;
+    T img = 0;
+};
+
+template <typename T>
+struct ComplexMagnitudeExtrema
+{
+    T minNorm = 0;
+    T maxNorm = 0;
+    std::size_t argMin = 0;
+    std::size_t argMax = 0;
+};
+
+// Runs _leaf(begin, end) for every leaf on _threads threads and folds the leaf results with _combine in a fixed pairwise tree.
+template <class ACC, class LEAF, class COMBINE>
+[[nodiscard]] ACC reduceTree(std::size_t _size, std::size_t _threads, const LEAF &_leaf, const COMBINE &_combine) noexcept(false)
+{
+    const std::size_t tLeaves = std::max<std::size_t>(1, (_size + kReduceLeafSize - 1) / kReduceLeafSize);
+    std::vector<ACC> tPartial(tLeaves);
+    complexParallelFor(tLeaves, _threads, [&](std::size_t _begin, std::size_t _end) noexcept
+                       {
+        COMPLEX_PERF_REGION("reduce", std::min(_size, _end * kReduceLeafSize) - _begin * kReduceLeafSize);
+        for (std::size_t l = _begin; l < _end; ++l)
+            tPartial[l] = _leaf(l * kReduceLeafSize, std::min(_size, (l + 1) * kReduceLeafSize)); });
+
+    for (std::size_t tStride = 1; tStride < tLeaves; tStride *= 2)
+        for (std::size_t i = 0; i + tStride < tLeaves; i += 2 * tStride)
+            tPartial[i] = _combine(tPartial[i], tPartial[i + tStride]);
+    return tPartial[0];
+}
+
+// Sums _value(i) over [_begin, _end) with kReduceLanes accumulators that are folded pairwise.
+template <typename T, class VALUE>
+[[nodiscard]] T reduceLanes(std::size_t _begin, std::size_t _end, const VALUE &_value) noexcept
+{
+    T tLanes[kReduceLanes] = {};
+    std::size_t i = _begin;
+    for (; i + kReduceLanes <= _end; i += kReduceLanes)
+        for (std::size_t l = 0; l < kReduceLanes; ++l)
+            tLanes[l] += _value(i + l);
+    for (std::size_t l = 0; i < _end; ++i, ++l)
+        tLanes[l] += _value(i);
+    for (std::size_t tStride = 1; tStride < kReduceLanes; tStride *= 2)
+        for (std::size_t l = 0; l + tStride < kReduceLanes; l += 2 * tStride)
+            tLanes[l] += tLanes[l + tStride];
+    return tLanes[0];
+}
+
+template <ComplexReadableView IN>
+[[nodiscard]] ComplexSumAccumulator<typename IN::value_type> reduceSumParts(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename IN::value_type;
+    using ACC = ComplexSumAccumulator<T>;
+    return reduceTree<ACC>(
+        _in.size(), _threads, [&_in](std::size_t _begin, std::size_t _end) noexcept
+        { return ACC{reduceLanes<T>(_begin, _end, [&_in](std::size_t _i) noexcept { return _in.real(_i); }),
+                     reduceLanes<T>(_begin, _end, [&_in](std::size_t _i) noexcept { return _in.imag(_i); })}; },
+        [](const ACC &_lh, const ACC &_rh) noexcept
+        { return ACC{_lh.re + _rh.re, _lh.img + _rh.img}; });
+}
+
+template <ComplexReadableView IN, class C = Complex<typename IN::value_type>>
+[[nodiscard]] C reduceSum(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    const auto tSum = reduceSumParts(_in, _threads);
+    return C(tSum.re, tSum.img);
+}
+
+template <ComplexReadableView IN, class C = Complex<typename IN::value_type>>
+[[nodiscard]] C reduceMean(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename IN::value_type;
+    if (_in.size() == 0)
+        throw std::invalid_argument("reduceMean: empty input");
+    const auto tSum = reduceSumParts(_in, _threads);
+    return C(tSum.re / static_cast<T>(_in.size()), tSum.img / static_cast<T>(_in.size()));
+}
+
+// Mean power E|x|^2.
+template <ComplexReadableView IN>
+[[nodiscard]] typename IN::value_type reducePower(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename IN::value_type;
+    if (_in.size() == 0)
+        throw std::invalid_argument("reducePower: empty input");
+    const T tEnergy = reduceTree<T>(
+        _in.size(), _threads, [&_in](std::size_t _begin, std::size_t _end) noexcept
+        { return reduceLanes<T>(_begin, _end, [&_in](std::size_t _i) noexcept
+                                { return _in.real(_i) * _in.real(_i) + _in.imag(_i) * _in.imag(_i); }); },
+        [](T _lh, T _rh) noexcept
+        { return _lh + _rh; });
+    return tEnergy / static_cast<T>(_in.size());
+}
+
+// Population variance E|x - mean|^2, computed in two passes to avoid the cancellation of E|x|^2 - |mean|^2.
+template <ComplexReadableView IN>
+[[nodiscard]] typename IN::value_type reduceVariance(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename IN::value_type;
+    if (_in.size() == 0)
+        throw std::invalid_argument("reduceVariance: empty input");
+    const auto tSum = reduceSumParts(_in, _threads);
+    const T tMeanRe = tSum.re / static_cast<T>(_in.size());
+    const T tMeanImg = tSum.img / static_cast<T>(_in.size());
+    const T tDeviation = reduceTree<T>(
+        _in.size(), _threads, [&](std::size_t _begin, std::size_t _end) noexcept
+        { return reduceLanes<T>(_begin, _end, [&](std::size_t _i) noexcept
+                                {
+            const T tRe = _in.real(_i) - tMeanRe;
+            const T tImg = _in.imag(_i) - tMeanImg;
+            return tRe * tRe + tImg * tImg; }); },
+        [](T _lh, T _rh) noexcept
+        { return _lh + _rh; });
+    return tDeviation / static_cast<T>(_in.size());
+}
+
+// Smallest and largest squared magnitude with their first index; ties resolve to the lower index.
+template <ComplexReadableView IN>
+[[nodiscard]] ComplexMagnitudeExtrema<typename IN::value_type> reduceMagnitudeExtrema(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    using T = typename IN::value_type;
+    using ACC = ComplexMagnitudeExtrema<T>;
+    if (_in.size() == 0)
+        throw std::invalid_argument("reduceMagnitudeExtrema: empty input");
+    return reduceTree<ACC>(
+        _in.size(), _threads, [&_in](std::size_t _begin, std::size_t _end) noexcept
+        {
+            ACC tResult;
+            if (_begin == _end)
+                return tResult;
+            tResult.minNorm = tResult.maxNorm = _in.real(_begin) * _in.real(_begin) + _in.imag(_begin) * _in.imag(_begin);
+            tResult.argMin = tResult.argMax = _begin;
+            for (std::size_t i = _begin + 1; i < _end; ++i)
+            {
+                const T tNorm = _in.real(i) * _in.real(i) + _in.imag(i) * _in.imag(i);
+                if (tNorm < tResult.minNorm)
+                {
+                    tResult.minNorm = tNorm;
+                    tResult.argMin = i;
+                }
+                if (tNorm > tResult.maxNorm)
+                {
+                    tResult.maxNorm = tNorm;
+                    tResult.argMax = i;
+                }
+            }
+            return tResult; },
+        [](const ACC &_lh, const ACC &_rh) noexcept
+        {
+            ACC tResult = _lh;
+            if (_rh.minNorm < _lh.minNorm)
+            {
+                tResult.minNorm = _rh.minNorm;
+                tResult.argMin = _rh.argMin;
+            }
+            if (_rh.maxNorm > _lh.maxNorm)
+            {
+                tResult.maxNorm = _rh.maxNorm;
+                tResult.argMax = _rh.argMax;
+            }
+            return tResult; });
+}
+
+template <ComplexReadableView IN>
+[[nodiscard]] typename IN::value_type reduceMinMagnitude(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    return std::sqrt(reduceMagnitudeExtrema(_in, _threads).minNorm);
+}
+
+template <ComplexReadableView IN>
+[[nodiscard]] typename IN::value_type reduceMaxMagnitude(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    return std::sqrt(reduceMagnitudeExtrema(_in, _threads).maxNorm);
+}
+
+template <ComplexReadableView IN>
+[[nodiscard]] std::size_t reduceArgMaxMagnitude(const IN &_in, std::size_t _threads = 0) noexcept(false)
+{
+    return reduceMagnitudeExtrema(_in, _threads).argMax;
+}
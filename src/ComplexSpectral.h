@@ -0,0 +1,293 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <numbers>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+#include "ComplexFFT.h"
+#include "ComplexParallel.h"
+#include "ComplexPerfRegion.h"
+
+// Streaming power spectra: Welch PSD estimation and spectrograms of long complex streams.
+// Samples are pushed in arbitrary pieces; complete segments are windowed, transformed with one reused FFTPlan and
+// reduced to |X|^2 directly (no sqrt/atan). Up to kSpectralBatch segments are transformed in parallel and then
+// consumed in stream order, so results do not depend on the thread count and memory stays bounded by the batch,
+// independent of the stream length.
+// All spectra are in FFT order (bin 0 is DC, bins above N/2 are the negative frequencies) and scaled as a power
+// spectral density |X|^2 / (sampleRate * sum(w^2)).
+
+enum class WindowType
+{
+    Rectangular,
+    Hann,
+    Hamming,
+    Blackman
+};
+
+enum class SpectralAveraging
+{
+    // Arithmetic mean over all segments (classic Welch estimate).
+    Mean,
+    // Exponentially weighted mean, the newest segment gets the weight exponentialFactor.
+    Exponential,
+    // Maximum per bin (peak hold).
+    Peak
+};
+
+template <typename T>
+struct SpectralOptions
+{
+    std::size_t segmentLength = 1024;
+    std::size_t overlap = 512;
+    WindowType window = WindowType::Hann;
+    T sampleRate = 1;
+    SpectralAveraging averaging = SpectralAveraging::Mean;
+    T exponentialFactor = T(0.1);
+    // Spectrogram only: number of consecutive segments averaged into one row.
+    std::size_t segmentsPerRow = 1;
+    // 0: one thread per hardware thread
+    std::size_t threads = 0;
+};
+
+// Periodic window of the given length (the DFT-even form used for spectral analysis).
+template <typename T, class COS = default_cos<T>>
+[[nodiscard]] std::vector<T> makeWindow(WindowType _type, std::size_t _length, const COS &_cos = COS{}) noexcept(false)
+{
+    std::vector<T> tWindow(_length, T(1));
+    for (std::size_t i = 0; i < _length; ++i)
+    {
+        const T tPhase = static_cast<T>(2 * std::numbers::pi_v<T> * static_cast<T>(i) / static_cast<T>(_length));
+        switch (_type)
+        {
+        case WindowType::Rectangular:
+            break;
+        case WindowType::Hann:
+            tWindow[i] = T(0.5) - T(0.5) * _cos(tPhase);
+            break;
+        case WindowType::Hamming:
+            tWindow[i] = T(0.54) - T(0.46) * _cos(tPhase);
+            break;
+        case WindowType::Blackman:
+            tWindow[i] = T(0.42) - T(0.5) * _cos(tPhase) + T(0.08) * _cos(2 * tPhase);
+            break;
+        }
+    }
+    return tWindow;
+}
+
+constexpr std::size_t kSpectralBatch = 32;
+// Minimum number of samples per thread of a segment batch.
+constexpr std::size_t kSpectralGrainSamples = 16384;
+
+// Cuts a stream into overlapping windowed segments and hands |X|^2 of every segment (already density scaled) to a callback.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+class PowerSpectrumSegmenter
+{
+private:
+    std::size_t mLength = 0;
+    std::size_t mHop = 0;
+    std::size_t mThreads = 0;
+    FFTPlan<T, SIN, COS> mPlan;
+    std::vector<T> mWindow;
+    T mScale = 1;
+    std::vector<T> mPendingRe;
+    std::vector<T> mPendingImg;
+    std::vector<T> mSegmentRe;
+    std::vector<T> mSegmentImg;
+    std::size_t mSegments = 0;
+
+    template <class ON_SEGMENT>
+    void processPending(ON_SEGMENT &_onSegment) noexcept(false)
+    {
+        if (mPendingRe.size() < mLength)
+            return;
+        const std::size_t tCount = std::min(kSpectralBatch, (mPendingRe.size() - mLength) / mHop + 1);
+
+        complexParallelFor(tCount, mThreads, [&](std::size_t _begin, std::size_t _end) noexcept
+                           {
+            COMPLEX_PERF_REGION("spectralSegments", (_end - _begin) * mLength);
+            for (std::size_t s = _begin; s < _end; ++s)
+            {
+                T *tRe = mSegmentRe.data() + s * mLength;
+                T *tImg = mSegmentImg.data() + s * mLength;
+                const std::size_t tOffset = s * mHop;
+                for (std::size_t i = 0; i < mLength; ++i)
+                {
+                    tRe[i] = mPendingRe[tOffset + i] * mWindow[i];
+                    tImg[i] = mPendingImg[tOffset + i] * mWindow[i];
+                }
+                mPlan.transform(tRe, tImg, FFTDirection::Forward);
+                // The real plane receives the scaled power, the imaginary plane is not needed any more.
+                for (std::size_t i = 0; i < mLength; ++i)
+                    tRe[i] = (tRe[i] * tRe[i] + tImg[i] * tImg[i]) * mScale;
+            } }, std::max<std::size_t>(1, kSpectralGrainSamples / mLength));
+
+        for (std::size_t s = 0; s < tCount; ++s)
+            _onSegment(mSegments++, std::span<const T>(mSegmentRe.data() + s * mLength, mLength));
+
+        const auto tConsumed = static_cast<std::ptrdiff_t>(tCount * mHop);
+        mPendingRe.erase(mPendingRe.begin(), mPendingRe.begin() + tConsumed);
+        mPendingImg.erase(mPendingImg.begin(), mPendingImg.begin() + tConsumed);
+    }
+
+public:
+    explicit PowerSpectrumSegmenter(const SpectralOptions<T> &_options) noexcept(false)
+        : mLength(_options.segmentLength), mHop(_options.segmentLength - std::min(_options.overlap, _options.segmentLength)), mThreads(complexThreadCount(_options.threads)),
+          mPlan(_options.segmentLength), mWindow(makeWindow<T, COS>(_options.window, _options.segmentLength)),
+          mSegmentRe(kSpectralBatch * _options.segmentLength), mSegmentImg(kSpectralBatch * _options.segmentLength)
+    {
+        if (_options.overlap >= _options.segmentLength)
+            throw std::invalid_argument("PowerSpectrumSegmenter: overlap must be smaller than the segment length");
+        if (_options.sampleRate <= 0)
+            throw std::invalid_argument("PowerSpectrumSegmenter: sample rate must be positive");
+
+        T tWindowPower = 0;
+        for (const auto tValue : mWindow)
+            tWindowPower += tValue * tValue;
+        mScale = T(1) / (_options.sampleRate * tWindowPower);
+        mPendingRe.reserve(mLength + (kSpectralBatch - 1) * mHop);
+        mPendingImg.reserve(mLength + (kSpectralBatch - 1) * mHop);
+    }
+
+    [[nodiscard]] std::size_t getSegmentLength() const noexcept { return mLength; }
+    [[nodiscard]] std::size_t getSegmentCount() const noexcept { return mSegments; }
+
+    // _onSegment(segmentIndex, power) is called in stream order for every completed segment.
+    template <ComplexReadableView IN, class ON_SEGMENT>
+    void push(const IN &_in, ON_SEGMENT &&_onSegment) noexcept(false)
+    {
+        const std::size_t tCapacity = mLength + (kSpectralBatch - 1) * mHop;
+        for (std::size_t tConsumed = 0; tConsumed < _in.size();)
+        {
+            const std::size_t tTake = std::min(_in.size() - tConsumed, tCapacity - mPendingRe.size());
+            for (std::size_t i = 0; i < tTake; ++i)
+            {
+                mPendingRe.push_back(_in.real(tConsumed + i));
+                mPendingImg.push_back(_in.imag(tConsumed + i));
+            }
+            tConsumed += tTake;
+            processPending(_onSegment);
+        }
+    }
+
+    void reset() noexcept
+    {
+        mPendingRe.clear();
+        mPendingImg.clear();
+        mSegments = 0;
+    }
+};
+
+// Welch power spectral density estimate over everything pushed so far.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+class WelchEstimator
+{
+private:
+    SpectralOptions<T> mOptions;
+    PowerSpectrumSegmenter<T, SIN, COS> mSegmenter;
+    std::vector<T> mAccumulator;
+    std::vector<T> mPsd;
+    std::size_t mAveraged = 0;
+
+public:
+    explicit WelchEstimator(const SpectralOptions<T> &_options = {}) noexcept(false)
+        : mOptions(_options), mSegmenter(_options), mAccumulator(_options.segmentLength), mPsd(_options.segmentLength)
+    {
+    }
+
+    template <ComplexReadableView IN>
+    void push(const IN &_in) noexcept(false)
+    {
+        mSegmenter.push(_in, [this](std::size_t, std::span<const T> _power) noexcept
+                        {
+            const std::size_t tLength = _power.size();
+            switch (mOptions.averaging)
+            {
+            case SpectralAveraging::Mean:
+                for (std::size_t i = 0; i < tLength; ++i)
+                    mAccumulator[i] += _power[i];
+                break;
+            case SpectralAveraging::Exponential:
+                for (std::size_t i = 0; i < tLength; ++i)
+                    mAccumulator[i] = mAveraged == 0 ? _power[i] : mAccumulator[i] + mOptions.exponentialFactor * (_power[i] - mAccumulator[i]);
+                break;
+            case SpectralAveraging::Peak:
+                for (std::size_t i = 0; i < tLength; ++i)
+                    mAccumulator[i] = mAveraged == 0 ? _power[i] : std::max(mAccumulator[i], _power[i]);
+                break;
+            }
+            ++mAveraged; });
+    }
+
+    [[nodiscard]] std::size_t getSegmentCount() const noexcept { return mAveraged; }
+
+    // Current estimate, all zero until the first segment completed.
+    [[nodiscard]] std::span<const T> getPsd() noexcept
+    {
+        const T tScale = (mOptions.averaging == SpectralAveraging::Mean && mAveraged != 0) ? T(1) / static_cast<T>(mAveraged) : T(1);
+        for (std::size_t i = 0; i < mPsd.size(); ++i)
+            mPsd[i] = mAccumulator[i] * tScale;
+        return mPsd;
+    }
+
+    void reset() noexcept
+    {
+        mSegmenter.reset();
+        std::fill(mAccumulator.begin(), mAccumulator.end(), T{0});
+        mAveraged = 0;
+    }
+};
+
+// Spectrogram: emits one PSD row per segmentsPerRow segments as soon as it is complete, nothing is kept in memory.
+template <typename T, class SIN = default_sin<T>, class COS = default_cos<T>>
+class Spectrogram
+{
+private:
+    SpectralOptions<T> mOptions;
+    PowerSpectrumSegmenter<T, SIN, COS> mSegmenter;
+    std::vector<T> mRow;
+    std::size_t mRowSegments = 0;
+    std::size_t mRows = 0;
+
+public:
+    explicit Spectrogram(const SpectralOptions<T> &_options = {}) noexcept(false)
+        : mOptions(_options), mSegmenter(_options), mRow(_options.segmentLength)
+    {
+        if (_options.segmentsPerRow == 0)
+            throw std::invalid_argument("Spectrogram: segmentsPerRow must not be 0");
+    }
+
+    // _onRow(rowIndex, psd) is called for every completed row in stream order.
+    template <ComplexReadableView IN, class ON_ROW>
+    void push(const IN &_in, ON_ROW &&_onRow) noexcept(false)
+    {
+        mSegmenter.push(_in, [&](std::size_t, std::span<const T> _power)
+                        {
+            for (std::size_t i = 0; i < _power.size(); ++i)
+                mRow[i] += _power[i];
+            if (++mRowSegments == mOptions.segmentsPerRow)
+            {
+                const T tScale = T(1) / static_cast<T>(mRowSegments);
+                for (auto &tValue : mRow)
+                    tValue *= tScale;
+                _onRow(mRows++, std::span<const T>(mRow));
+                std::fill(mRow.begin(), mRow.end(), T{0});
+                mRowSegments = 0;
+            } });
+    }
+
+    [[nodiscard]] std::size_t getRowCount() const noexcept { return mRows; }
+
+    void reset() noexcept
+    {
+        mSegmenter.reset();
+        std::fill(mRow.begin(), mRow.end(), T{0});
+        mRowSegments = 0;
+        mRows = 0;
+    }
+};
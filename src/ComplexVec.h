@@ -0,0 +1,370 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+
+#include "Complex.h"
+#include "ComplexView.h"
+
+// Fixed size complex vectors and matrices for small groups (antennas, taps, ...).
+// Sizes are template parameters and data is kept in split real/imaginary std::arrays, so every kernel below is
+// expanded by complexUnroll into straight line code the compiler can keep in registers, without loops or aliasing
+// between the planes. All operations are constexpr and work on the raw planes; no Complex (and thus no sqrt/atan)
+// is constructed except where a Complex is returned. Matrix inversion pivots on the squared magnitude.
+
+// Calls _f(0), _f(1), ..., _f(N - 1) as an unrolled sequence.
+template <std::size_t N, class F>
+constexpr void complexUnroll(F &&_f) noexcept(noexcept(_f(std::size_t{0})))
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    { (_f(I), ...); }(std::make_index_sequence<N>{});
+}
+
+template <typename T, std::size_t N>
+class ComplexVec
+{
+    static_assert(N > 0, "ComplexVec: N must not be 0");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t kSize = N;
+
+private:
+    std::array<T, N> mRe{};
+    std::array<T, N> mImg{};
+
+public:
+    constexpr ComplexVec() noexcept = default;
+    constexpr ComplexVec(const std::array<T, N> &_re, const std::array<T, N> &_img) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : mRe(_re), mImg(_img)
+    {
+    }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr explicit ComplexVec(const std::array<Complex<T, SIN, COS, POW2, SQRT, ATAN>, N> &_values) noexcept
+    {
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         { set(i, _values[i].getReal(), _values[i].getImaginary()); });
+    }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+    [[nodiscard]] constexpr const T &real(std::size_t _index) const noexcept { return mRe[_index]; }
+    [[nodiscard]] constexpr const T &imag(std::size_t _index) const noexcept { return mImg[_index]; }
+    [[nodiscard]] constexpr const std::array<T, N> &getReal() const noexcept { return mRe; }
+    [[nodiscard]] constexpr const std::array<T, N> &getImaginary() const noexcept { return mImg; }
+    constexpr void set(std::size_t _index, const T &_re, const T &_img) noexcept
+    {
+        mRe[_index] = _re;
+        mImg[_index] = _img;
+    }
+
+    template <class C = Complex<T>>
+    [[nodiscard]] constexpr C load(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<T>)
+    {
+        return C(mRe[_index], mImg[_index]);
+    }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr void store(std::size_t _index, const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_complex) noexcept
+    {
+        set(_index, _complex.getReal(), _complex.getImaginary());
+    }
+
+    [[nodiscard]] ComplexSplitSpan<T> view() noexcept { return ComplexSplitSpan<T>(mRe.data(), mImg.data(), N); }
+    [[nodiscard]] ComplexSplitSpan<const T> view() const noexcept { return ComplexSplitSpan<const T>(mRe.data(), mImg.data(), N); }
+
+    constexpr ComplexVec &operator+=(const ComplexVec &_vec) noexcept
+    {
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            mRe[i] += _vec.mRe[i];
+            mImg[i] += _vec.mImg[i]; });
+        return *this;
+    }
+    constexpr ComplexVec &operator-=(const ComplexVec &_vec) noexcept
+    {
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            mRe[i] -= _vec.mRe[i];
+            mImg[i] -= _vec.mImg[i]; });
+        return *this;
+    }
+    // Element-wise (Hadamard) product
+    constexpr ComplexVec &operator*=(const ComplexVec &_vec) noexcept
+    {
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            const T tRe = mRe[i] * _vec.mRe[i] - mImg[i] * _vec.mImg[i];
+            mImg[i] = mRe[i] * _vec.mImg[i] + mImg[i] * _vec.mRe[i];
+            mRe[i] = tRe; });
+        return *this;
+    }
+    constexpr ComplexVec &operator*=(const T &_scale) noexcept
+    {
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            mRe[i] *= _scale;
+            mImg[i] *= _scale; });
+        return *this;
+    }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr ComplexVec &operator*=(const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_scale) noexcept
+    {
+        const T tScaleRe = _scale.getReal();
+        const T tScaleImg = _scale.getImaginary();
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            const T tRe = mRe[i] * tScaleRe - mImg[i] * tScaleImg;
+            mImg[i] = mRe[i] * tScaleImg + mImg[i] * tScaleRe;
+            mRe[i] = tRe; });
+        return *this;
+    }
+
+    [[nodiscard]] constexpr ComplexVec operator+(const ComplexVec &_vec) const noexcept { return ComplexVec(*this) += _vec; }
+    [[nodiscard]] constexpr ComplexVec operator-(const ComplexVec &_vec) const noexcept { return ComplexVec(*this) -= _vec; }
+    [[nodiscard]] constexpr ComplexVec operator*(const ComplexVec &_vec) const noexcept { return ComplexVec(*this) *= _vec; }
+    [[nodiscard]] constexpr ComplexVec operator*(const T &_scale) const noexcept { return ComplexVec(*this) *= _scale; }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    [[nodiscard]] constexpr ComplexVec operator*(const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_scale) const noexcept { return ComplexVec(*this) *= _scale; }
+
+    [[nodiscard]] constexpr ComplexVec conjugate() const noexcept
+    {
+        ComplexVec tResult(*this);
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         { tResult.mImg[i] = -mImg[i]; });
+        return tResult;
+    }
+
+    // Squared Euclidean norm sum |v_i|^2
+    [[nodiscard]] constexpr T norm() const noexcept
+    {
+        T tSum = 0;
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         { tSum += mRe[i] * mRe[i] + mImg[i] * mImg[i]; });
+        return tSum;
+    }
+
+    constexpr bool operator==(const ComplexVec &_vec) const noexcept = default;
+};
+
+// Hermitian inner product sum conj(a_i) * b_i
+template <typename T, std::size_t N, class C = Complex<T>>
+[[nodiscard]] constexpr C dot(const ComplexVec<T, N> &_lh, const ComplexVec<T, N> &_rh) noexcept(std::is_nothrow_constructible_v<T>)
+{
+    T tRe = 0;
+    T tImg = 0;
+    complexUnroll<N>([&](std::size_t i) noexcept
+                     {
+        tRe += _lh.real(i) * _rh.real(i) + _lh.imag(i) * _rh.imag(i);
+        tImg += _lh.real(i) * _rh.imag(i) - _lh.imag(i) * _rh.real(i); });
+    return C(tRe, tImg);
+}
+
+// Unconjugated product sum a_i * b_i, e.g. for FIR taps.
+template <typename T, std::size_t N, class C = Complex<T>>
+[[nodiscard]] constexpr C dotu(const ComplexVec<T, N> &_lh, const ComplexVec<T, N> &_rh) noexcept(std::is_nothrow_constructible_v<T>)
+{
+    T tRe = 0;
+    T tImg = 0;
+    complexUnroll<N>([&](std::size_t i) noexcept
+                     {
+        tRe += _lh.real(i) * _rh.real(i) - _lh.imag(i) * _rh.imag(i);
+        tImg += _lh.real(i) * _rh.imag(i) + _lh.imag(i) * _rh.real(i); });
+    return C(tRe, tImg);
+}
+
+// N x M matrix, row-major split planes.
+template <typename T, std::size_t N, std::size_t M>
+class ComplexMat
+{
+    static_assert(N > 0 && M > 0, "ComplexMat: dimensions must not be 0");
+
+public:
+    using value_type = T;
+    static constexpr std::size_t kRows = N;
+    static constexpr std::size_t kCols = M;
+
+private:
+    std::array<T, N * M> mRe{};
+    std::array<T, N * M> mImg{};
+
+public:
+    constexpr ComplexMat() noexcept = default;
+    constexpr ComplexMat(const std::array<T, N * M> &_re, const std::array<T, N * M> &_img) noexcept(std::is_nothrow_copy_constructible_v<T>)
+        : mRe(_re), mImg(_img)
+    {
+    }
+
+    [[nodiscard]] static constexpr ComplexMat identity() noexcept requires(N == M)
+    {
+        ComplexMat tResult;
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         { tResult.mRe[i * M + i] = 1; });
+        return tResult;
+    }
+
+    [[nodiscard]] static constexpr std::size_t rows() noexcept { return N; }
+    [[nodiscard]] static constexpr std::size_t cols() noexcept { return M; }
+    [[nodiscard]] constexpr const T &real(std::size_t _row, std::size_t _col) const noexcept { return mRe[_row * M + _col]; }
+    [[nodiscard]] constexpr const T &imag(std::size_t _row, std::size_t _col) const noexcept { return mImg[_row * M + _col]; }
+    constexpr void set(std::size_t _row, std::size_t _col, const T &_re, const T &_img) noexcept
+    {
+        mRe[_row * M + _col] = _re;
+        mImg[_row * M + _col] = _img;
+    }
+
+    template <class C = Complex<T>>
+    [[nodiscard]] constexpr C load(std::size_t _row, std::size_t _col) const noexcept(std::is_nothrow_constructible_v<T>)
+    {
+        return C(real(_row, _col), imag(_row, _col));
+    }
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr void store(std::size_t _row, std::size_t _col, const Complex<T, SIN, COS, POW2, SQRT, ATAN> &_complex) noexcept
+    {
+        set(_row, _col, _complex.getReal(), _complex.getImaginary());
+    }
+
+    constexpr ComplexMat &operator+=(const ComplexMat &_mat) noexcept
+    {
+        complexUnroll<N * M>([&](std::size_t i) noexcept
+                             {
+            mRe[i] += _mat.mRe[i];
+            mImg[i] += _mat.mImg[i]; });
+        return *this;
+    }
+    constexpr ComplexMat &operator-=(const ComplexMat &_mat) noexcept
+    {
+        complexUnroll<N * M>([&](std::size_t i) noexcept
+                             {
+            mRe[i] -= _mat.mRe[i];
+            mImg[i] -= _mat.mImg[i]; });
+        return *this;
+    }
+    constexpr ComplexMat &operator*=(const T &_scale) noexcept
+    {
+        complexUnroll<N * M>([&](std::size_t i) noexcept
+                             {
+            mRe[i] *= _scale;
+            mImg[i] *= _scale; });
+        return *this;
+    }
+
+    [[nodiscard]] constexpr ComplexMat operator+(const ComplexMat &_mat) const noexcept { return ComplexMat(*this) += _mat; }
+    [[nodiscard]] constexpr ComplexMat operator-(const ComplexMat &_mat) const noexcept { return ComplexMat(*this) -= _mat; }
+    [[nodiscard]] constexpr ComplexMat operator*(const T &_scale) const noexcept { return ComplexMat(*this) *= _scale; }
+
+    template <std::size_t K>
+    [[nodiscard]] constexpr ComplexMat<T, N, K> operator*(const ComplexMat<T, M, K> &_mat) const noexcept
+    {
+        ComplexMat<T, N, K> tResult;
+        complexUnroll<N * K>([&](std::size_t o) noexcept
+                             {
+            const std::size_t tRow = o / K;
+            const std::size_t tCol = o % K;
+            T tRe = 0;
+            T tImg = 0;
+            complexUnroll<M>([&](std::size_t j) noexcept
+                             {
+                tRe += real(tRow, j) * _mat.real(j, tCol) - imag(tRow, j) * _mat.imag(j, tCol);
+                tImg += real(tRow, j) * _mat.imag(j, tCol) + imag(tRow, j) * _mat.real(j, tCol); });
+            tResult.set(tRow, tCol, tRe, tImg); });
+        return tResult;
+    }
+
+    [[nodiscard]] constexpr ComplexVec<T, N> operator*(const ComplexVec<T, M> &_vec) const noexcept
+    {
+        ComplexVec<T, N> tResult;
+        complexUnroll<N>([&](std::size_t i) noexcept
+                         {
+            T tRe = 0;
+            T tImg = 0;
+            complexUnroll<M>([&](std::size_t j) noexcept
+                             {
+                tRe += real(i, j) * _vec.real(j) - imag(i, j) * _vec.imag(j);
+                tImg += real(i, j) * _vec.imag(j) + imag(i, j) * _vec.real(j); });
+            tResult.set(i, tRe, tImg); });
+        return tResult;
+    }
+
+    [[nodiscard]] constexpr ComplexMat<T, M, N> transpose() const noexcept
+    {
+        ComplexMat<T, M, N> tResult;
+        complexUnroll<N * M>([&](std::size_t o) noexcept
+                             { tResult.set(o % M, o / M, mRe[o], mImg[o]); });
+        return tResult;
+    }
+
+    // Conjugate transpose
+    [[nodiscard]] constexpr ComplexMat<T, M, N> hermitian() const noexcept
+    {
+        ComplexMat<T, M, N> tResult;
+        complexUnroll<N * M>([&](std::size_t o) noexcept
+                             { tResult.set(o % M, o / M, mRe[o], -mImg[o]); });
+        return tResult;
+    }
+
+    // Gauss-Jordan elimination with partial pivoting on |a|^2. Throws if a pivot is exactly 0.
+    [[nodiscard]] constexpr ComplexMat inverse() const noexcept(false) requires(N == M)
+    {
+        ComplexMat tWork(*this);
+        ComplexMat tResult = identity();
+        for (std::size_t c = 0; c < N; ++c)
+        {
+            std::size_t tPivot = c;
+            T tPivotNorm = tWork.real(c, c) * tWork.real(c, c) + tWork.imag(c, c) * tWork.imag(c, c);
+            for (std::size_t r = c + 1; r < N; ++r)
+            {
+                const T tNorm = tWork.real(r, c) * tWork.real(r, c) + tWork.imag(r, c) * tWork.imag(r, c);
+                if (tNorm > tPivotNorm)
+                {
+                    tPivot = r;
+                    tPivotNorm = tNorm;
+                }
+            }
+            if (tPivotNorm == 0)
+                throw std::invalid_argument("ComplexMat::inverse: matrix is singular");
+            if (tPivot != c)
+            {
+                complexUnroll<N>([&](std::size_t j) noexcept
+                                 {
+                    std::swap(tWork.mRe[c * M + j], tWork.mRe[tPivot * M + j]);
+                    std::swap(tWork.mImg[c * M + j], tWork.mImg[tPivot * M + j]);
+                    std::swap(tResult.mRe[c * M + j], tResult.mRe[tPivot * M + j]);
+                    std::swap(tResult.mImg[c * M + j], tResult.mImg[tPivot * M + j]); });
+            }
+
+            // Scale the pivot row by 1 / pivot = conj(pivot) / |pivot|^2.
+            const T tInverseRe = tWork.real(c, c) / tPivotNorm;
+            const T tInverseImg = -tWork.imag(c, c) / tPivotNorm;
+            complexUnroll<N>([&](std::size_t j) noexcept
+                             {
+                const std::size_t tIndex = c * M + j;
+                const T tWorkRe = tWork.mRe[tIndex] * tInverseRe - tWork.mImg[tIndex] * tInverseImg;
+                tWork.mImg[tIndex] = tWork.mRe[tIndex] * tInverseImg + tWork.mImg[tIndex] * tInverseRe;
+                tWork.mRe[tIndex] = tWorkRe;
+                const T tResultRe = tResult.mRe[tIndex] * tInverseRe - tResult.mImg[tIndex] * tInverseImg;
+                tResult.mImg[tIndex] = tResult.mRe[tIndex] * tInverseImg + tResult.mImg[tIndex] * tInverseRe;
+                tResult.mRe[tIndex] = tResultRe; });
+
+            // Eliminate column c from all other rows.
+            complexUnroll<N>([&](std::size_t r) noexcept
+                             {
+                if (r == c)
+                    return;
+                const T tFactorRe = tWork.real(r, c);
+                const T tFactorImg = tWork.imag(r, c);
+                complexUnroll<N>([&](std::size_t j) noexcept
+                                 {
+                    const std::size_t tIndex = r * M + j;
+                    const std::size_t tPivotIndex = c * M + j;
+                    tWork.mRe[tIndex] -= tFactorRe * tWork.mRe[tPivotIndex] - tFactorImg * tWork.mImg[tPivotIndex];
+                    tWork.mImg[tIndex] -= tFactorRe * tWork.mImg[tPivotIndex] + tFactorImg * tWork.mRe[tPivotIndex];
+                    tResult.mRe[tIndex] -= tFactorRe * tResult.mRe[tPivotIndex] - tFactorImg * tResult.mImg[tPivotIndex];
+                    tResult.mImg[tIndex] -= tFactorRe * tResult.mImg[tPivotIndex] + tFactorImg * tResult.mRe[tPivotIndex]; }); });
+        }
+        return tResult;
+    }
+
+    constexpr bool operator==(const ComplexMat &_mat) const noexcept = default;
+};
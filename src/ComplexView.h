@@ -0,0 +1,181 @@
+#pragma once
+
+#include <span>
+#include <complex>
+#include <concepts>
+#include <stdexcept>
+#include <cstddef>
+#include <type_traits>
+
+#include "Complex.h"
+
+// Non-owning views over complex sample buffers that are not made of Complex objects.
+// They let the batch kernels read and write foreign layouts in place instead of copying
+// into a std::vector<Complex<T>> first:
+//  - ComplexInterleavedSpan: re0, im0, re1, im1, ... (raw interleaved arrays and std::complex<T> arrays)
+//  - ComplexSplitSpan: one plane with all real parts and one plane with all imaginary parts
+// A view of const T is read only. Like std::span, copying a view never copies the samples.
+
+template <class V>
+concept ComplexReadableView = requires(const V &_view, std::size_t _index) {
+    typename V::value_type;
+    { _view.size() } -> std::convertible_to<std::size_t>;
+    { _view.real(_index) } -> std::convertible_to<typename V::value_type>;
+    { _view.imag(_index) } -> std::convertible_to<typename V::value_type>;
+};
+
+template <class V>
+concept ComplexWritableView = ComplexReadableView<V> && requires(const V &_view, std::size_t _index, const typename V::value_type &_value) {
+    _view.set(_index, _value, _value);
+};
+
+template <typename T>
+class ComplexInterleavedSpan
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+
+private:
+    T *mData = nullptr;
+    std::size_t mSize = 0;
+
+public:
+    constexpr ComplexInterleavedSpan() noexcept = default;
+
+    // _size is the number of complex values, _data has to hold 2 * _size elements.
+    constexpr ComplexInterleavedSpan(T *_data, std::size_t _size) noexcept
+        : mData(_data), mSize(_size)
+    {
+    }
+
+    // std::complex<T> is guaranteed to be layout compatible with T[2] (array-oriented access).
+    ComplexInterleavedSpan(std::span<std::complex<value_type>> _data) noexcept
+        requires(!std::is_const_v<T>)
+        : mData(reinterpret_cast<value_type *>(_data.data())), mSize(_data.size())
+    {
+    }
+
+    ComplexInterleavedSpan(std::span<const std::complex<value_type>> _data) noexcept
+        requires std::is_const_v<T>
+        : mData(reinterpret_cast<const value_type *>(_data.data())), mSize(_data.size())
+    {
+    }
+
+    template <typename U>
+        requires(std::is_const_v<T> && std::is_same_v<U, value_type>)
+    constexpr ComplexInterleavedSpan(const ComplexInterleavedSpan<U> &_other) noexcept
+        : mData(_other.data()), mSize(_other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr T *data() const noexcept { return mData; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return mSize; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return mSize == 0; }
+
+    [[nodiscard]] constexpr const value_type &real(std::size_t _index) const noexcept { return mData[2 * _index]; }
+    [[nodiscard]] constexpr const value_type &imag(std::size_t _index) const noexcept { return mData[2 * _index + 1]; }
+
+    constexpr void set(std::size_t _index, const value_type &_re, const value_type &_img) const noexcept
+        requires(!std::is_const_v<T>)
+    {
+        mData[2 * _index] = _re;
+        mData[2 * _index + 1] = _img;
+    }
+
+    [[nodiscard]] constexpr ComplexInterleavedSpan subspan(std::size_t _offset, std::size_t _count) const noexcept
+    {
+        return ComplexInterleavedSpan(mData + 2 * _offset, _count);
+    }
+
+    template <class C = Complex<value_type>>
+    [[nodiscard]] constexpr C load(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<value_type>)
+    {
+        return C(real(_index), imag(_index));
+    }
+
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr void store(std::size_t _index, const Complex<value_type, SIN, COS, POW2, SQRT, ATAN> &_complex) const noexcept
+        requires(!std::is_const_v<T>)
+    {
+        set(_index, _complex.getReal(), _complex.getImaginary());
+    }
+};
+
+template <typename T>
+class ComplexSplitSpan
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_const_t<T>;
+
+private:
+    T *mRe = nullptr;
+    T *mImg = nullptr;
+    std::size_t mSize = 0;
+
+public:
+    constexpr ComplexSplitSpan() noexcept = default;
+
+    constexpr ComplexSplitSpan(T *_re, T *_img, std::size_t _size) noexcept
+        : mRe(_re), mImg(_img), mSize(_size)
+    {
+    }
+
+    constexpr ComplexSplitSpan(std::span<T> _re, std::span<T> _img) noexcept(false)
+        : mRe(_re.data()), mImg(_img.data()), mSize(_re.size())
+    {
+        if (_re.size() != _img.size())
+            throw std::invalid_argument("ComplexSplitSpan: real and imaginary plane must have the same size");
+    }
+
+    template <typename U>
+        requires(std::is_const_v<T> && std::is_same_v<U, value_type>)
+    constexpr ComplexSplitSpan(const ComplexSplitSpan<U> &_other) noexcept
+        : mRe(_other.realData()), mImg(_other.imagData()), mSize(_other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr T *realData() const noexcept { return mRe; }
+    [[nodiscard]] constexpr T *imagData() const noexcept { return mImg; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return mSize; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return mSize == 0; }
+
+    [[nodiscard]] constexpr const value_type &real(std::size_t _index) const noexcept { return mRe[_index]; }
+    [[nodiscard]] constexpr const value_type &imag(std::size_t _index) const noexcept { return mImg[_index]; }
+
+    constexpr void set(std::size_t _index, const value_type &_re, const value_type &_img) const noexcept
+        requires(!std::is_const_v<T>)
+    {
+        mRe[_index] = _re;
+        mImg[_index] = _img;
+    }
+
+    [[nodiscard]] constexpr ComplexSplitSpan subspan(std::size_t _offset, std::size_t _count) const noexcept
+    {
+        return ComplexSplitSpan(mRe + _offset, mImg + _offset, _count);
+    }
+
+    template <class C = Complex<value_type>>
+    [[nodiscard]] constexpr C load(std::size_t _index) const noexcept(std::is_nothrow_constructible_v<value_type>)
+    {
+        return C(real(_index), imag(_index));
+    }
+
+    template <class SIN, class COS, class POW2, class SQRT, class ATAN>
+    constexpr void store(std::size_t _index, const Complex<value_type, SIN, COS, POW2, SQRT, ATAN> &_complex) const noexcept
+        requires(!std::is_const_v<T>)
+    {
+        set(_index, _complex.getReal(), _complex.getImaginary());
+    }
+};
+
+// Copies between any two views (e.g. std::complex<T> array -> split planes) without intermediate Complex objects.
+template <ComplexReadableView IN, ComplexWritableView OUT>
+constexpr void copyView(const IN &_in, const OUT &_out) noexcept(false)
+{
+    if (_in.size() != _out.size())
+        throw std::invalid_argument("copyView: views must have the same size");
+    for (std::size_t i = 0; i < _in.size(); ++i)
+        _out.set(i, _in.real(i), _in.imag(i));
+}
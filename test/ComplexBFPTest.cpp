@@ -0,0 +1,145 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <limits>
+#include "ComplexBFP.h"
+#include "ComplexRandom.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::vector<std::complex<float>> makeSignal(std::size_t _size)
+    {
+        std::vector<std::complex<float>> tSignal(_size);
+        PhiloxStream tStream(3);
+        generateComplexGaussian(ComplexInterleavedSpan<float>(tSignal), tStream, 1.0f);
+        return tSignal;
+    }
+}
+
+TEST(ComplexBFPTest, PackBits)
+{
+    const std::vector<std::int32_t> tValues = {0, 1, -1, 2047, -2047, -2048, 5, -300};
+    std::vector<std::uint8_t> tPacked(bfpPackedSize(tValues.size(), 12));
+    EXPECT_EQ(tPacked.size(), 12u);
+    bfpPackBits(tValues.data(), tValues.size(), 12, tPacked.data());
+    std::vector<std::int32_t> tUnpacked(tValues.size());
+    bfpUnpackBits(tPacked.data(), tValues.size(), 12, tUnpacked.data());
+    EXPECT_EQ(tUnpacked, tValues);
+}
+
+TEST(ComplexBFPTest, LossyRoundTrip)
+{
+    const auto tSignal = makeSignal(10000);
+    BFPOptions tOptions;
+    tOptions.blockSize = 128;
+    tOptions.mantissaBits = 12;
+    BFPEncoder<float> tEncoder(tOptions);
+    const ComplexInterleavedSpan<const float> tView(tSignal);
+    tEncoder.push(tView.subspan(0, 3000));
+    tEncoder.push(tView.subspan(3000, 7000));
+    tEncoder.flush();
+
+    EXPECT_EQ(tEncoder.getSampleCount(), tSignal.size());
+    EXPECT_EQ(tEncoder.getBlockCount(), 79u);
+    EXPECT_EQ(tEncoder.getRawBlockCount(), 0u);
+    // 3 bytes per sample plus the block headers
+    EXPECT_EQ(tEncoder.getData().size(), 78 * (kBFPHeaderSize + 384) + kBFPHeaderSize + 16 * 3);
+
+    BFPDecoder<float> tDecoder(tEncoder.getData());
+    ASSERT_EQ(tDecoder.getBlockCount(), tEncoder.getBlockCount());
+    for (std::size_t b = 0; b < tDecoder.getBlockCount(); ++b)
+        EXPECT_EQ(tDecoder.getBlockInfo(b).offset, tEncoder.getOffsets()[b]);
+
+    std::vector<std::complex<float>> tDecoded(tSignal.size());
+    tDecoder.decode(ComplexInterleavedSpan<float>(tDecoded));
+    for (std::size_t b = 0; b < tDecoder.getBlockCount(); ++b)
+    {
+        // Error bound: half a quantization step of the block.
+        const float tStep = std::ldexp(1.0f, tDecoder.getBlockInfo(b).shift);
+        for (std::size_t i = b * 128; i < std::min(tSignal.size(), (b + 1) * 128); ++i)
+        {
+            EXPECT_LE(std::abs(tDecoded[i].real() - tSignal[i].real()), tStep / 2);
+            EXPECT_LE(std::abs(tDecoded[i].imag() - tSignal[i].imag()), tStep / 2);
+        }
+    }
+
+    // Random access to a single block matches the full decode.
+    std::vector<std::complex<float>> tBlock(128);
+    EXPECT_EQ(tDecoder.decodeBlock(42, ComplexInterleavedSpan<float>(tBlock)), 128u);
+    for (std::size_t i = 0; i < 128; ++i)
+        EXPECT_EQ(tBlock[i], tDecoded[42 * 128 + i]);
+    EXPECT_EQ(tDecoder.decodeBlock(78, ComplexInterleavedSpan<float>(tBlock)), 16u);
+    EXPECT_THROW(static_cast<void>(tDecoder.decodeBlock(79, ComplexInterleavedSpan<float>(tBlock))), std::out_of_range);
+}
+
+TEST(ComplexBFPTest, LosslessFallsBackToRaw)
+{
+    std::vector<std::complex<float>> tSignal(64);
+    // First block: small integers, exactly representable with 8 bit mantissas.
+    for (std::size_t i = 0; i < 32; ++i)
+        tSignal[i] = {static_cast<float>(i) - 16.0f, 3.0f};
+    // Second block: full precision values and a NaN.
+    const auto tNoise = makeSignal(32);
+    std::copy(tNoise.begin(), tNoise.end(), tSignal.begin() + 32);
+    tSignal[40] = {std::numeric_limits<float>::quiet_NaN(), 1.0f};
+
+    BFPOptions tOptions;
+    tOptions.blockSize = 32;
+    tOptions.mantissaBits = 8;
+    tOptions.lossless = true;
+    BFPEncoder<float> tEncoder(tOptions);
+    tEncoder.push(ComplexInterleavedSpan<const float>(tSignal));
+    tEncoder.flush();
+    EXPECT_EQ(tEncoder.getBlockCount(), 2u);
+    EXPECT_EQ(tEncoder.getRawBlockCount(), 1u);
+
+    BFPDecoder<float> tDecoder(tEncoder.getData());
+    EXPECT_EQ(tDecoder.getBlockInfo(0).mode, BFPBlockMode::Quantized);
+    EXPECT_EQ(tDecoder.getBlockInfo(1).mode, BFPBlockMode::Raw);
+    std::vector<std::complex<float>> tDecoded(tSignal.size());
+    tDecoder.decode(ComplexInterleavedSpan<float>(tDecoded), 1);
+    for (std::size_t i = 0; i < tSignal.size(); ++i)
+    {
+        if (i == 40)
+            EXPECT_TRUE(std::isnan(tDecoded[i].real()));
+        else
+            EXPECT_EQ(tDecoded[i], tSignal[i]);
+    }
+}
+
+TEST(ComplexBFPTest, InvalidInput)
+{
+    BFPOptions tOptions;
+    tOptions.mantissaBits = 1;
+    EXPECT_THROW(BFPEncoder<float>{tOptions}, std::invalid_argument);
+    tOptions.mantissaBits = 12;
+    tOptions.blockSize = 0;
+    EXPECT_THROW(BFPEncoder<float>{tOptions}, std::invalid_argument);
+
+    const std::vector<std::uint8_t> tTruncated = {0, 12, 4, 0, 0, 0, 1, 2};
+    EXPECT_THROW(BFPDecoder<float>{tTruncated}, std::invalid_argument);
+    const std::vector<std::uint8_t> tCorrupt = {7, 12, 1, 0, 0, 0, 1, 2, 3};
+    EXPECT_THROW(BFPDecoder<float>{tCorrupt}, std::invalid_argument);
+}
+
+TEST(ComplexBFPTest, NonFiniteBlocksStayRaw)
+{
+    std::vector<std::complex<float>> tSignal(16, {0.5f, -0.25f});
+    tSignal[3] = {1.0f, std::numeric_limits<float>::infinity()};
+    tSignal[7] = {std::numeric_limits<float>::quiet_NaN(), 0.0f};
+
+    BFPOptions tOptions;
+    tOptions.blockSize = 16;
+    BFPEncoder<float> tEncoder(tOptions);
+    tEncoder.push(ComplexInterleavedSpan<const float>(tSignal));
+    tEncoder.flush();
+    EXPECT_EQ(tEncoder.getRawBlockCount(), 1u);
+
+    std::vector<std::complex<float>> tDecoded(tSignal.size());
+    BFPDecoder<float>(tEncoder.getData()).decode(ComplexInterleavedSpan<float>(tDecoded));
+    EXPECT_TRUE(std::isinf(tDecoded[3].imag()));
+    EXPECT_TRUE(std::isnan(tDecoded[7].real()));
+    EXPECT_EQ(tDecoded[0], tSignal[0]);
+}
@@ -0,0 +1,145 @@
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include "ComplexBatch.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexBatchTest, ToPolar)
+{
+    const std::vector<double> tRe{8.0, 0.0, -13.5, 0.0, -1.0, 3.0};
+    const std::vector<double> tImg{-7.0, 2.0, 14.0, -2.0, 0.0, 0.0};
+    std::vector<double> tAbs(tRe.size());
+    std::vector<double> tPhi(tRe.size());
+
+    toPolar<double>(tRe, tImg, tAbs, tPhi);
+
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(tAbs[i], std::hypot(tRe[i], tImg[i]));
+        EXPECT_DOUBLE_EQ(tPhi[i], std::atan2(tImg[i], tRe[i]));
+    }
+    EXPECT_DOUBLE_EQ(tPhi[1], std::numbers::pi / 2);
+    EXPECT_DOUBLE_EQ(tPhi[2], 2.3380146751193666);
+    EXPECT_DOUBLE_EQ(tPhi[4], std::numbers::pi);
+}
+
+TEST(ComplexBatchTest, FromPolar)
+{
+    const std::vector<double> tAbs{25.0, 10.63014581273465, 2.0};
+    const std::vector<double> tPhi{1.08, -0.71882999962162453, std::numbers::pi / 2};
+    std::vector<double> tRe(tAbs.size());
+    std::vector<double> tImg(tAbs.size());
+
+    fromPolar<double>(tAbs, tPhi, tRe, tImg);
+
+    EXPECT_DOUBLE_EQ(tRe[0], 11.783209104343499);
+    EXPECT_DOUBLE_EQ(tImg[0], 22.048945172123688);
+    EXPECT_DOUBLE_EQ(tRe[1], 8.0);
+    EXPECT_DOUBLE_EQ(tImg[1], -7.0);
+    EXPECT_NEAR(tRe[2], 0.0, 1e-15);
+    EXPECT_DOUBLE_EQ(tImg[2], 2.0);
+}
+
+TEST(ComplexBatchTest, RoundTrip)
+{
+    std::vector<float> tRe(1000);
+    std::vector<float> tImg(1000);
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        tRe[i] = std::cos(0.37f * i) * (1.0f + i);
+        tImg[i] = std::sin(1.13f * i) * (1.0f + i);
+    }
+    std::vector<float> tAbs(tRe.size());
+    std::vector<float> tPhi(tRe.size());
+    std::vector<float> tRe2(tRe.size());
+    std::vector<float> tImg2(tRe.size());
+
+    toPolar<float>(tRe, tImg, tAbs, tPhi);
+    fromPolar<float>(tAbs, tPhi, tRe2, tImg2);
+
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        EXPECT_NEAR(tRe2[i], tRe[i], 1e-5f * (1.0f + i));
+        EXPECT_NEAR(tImg2[i], tImg[i], 1e-5f * (1.0f + i));
+    }
+}
+
+TEST(ComplexBatchTest, PolyFunctors)
+{
+    // Absolute errors relative to the magnitude of the result, within a few ULP.
+    for (int i = -20000; i <= 20000; ++i)
+    {
+        const double tX = i * 1e-3;
+        EXPECT_NEAR(poly_sin<double>{}(tX), std::sin(tX), 4e-16);
+        EXPECT_NEAR(poly_cos<double>{}(tX), std::cos(tX), 4e-16);
+        EXPECT_NEAR(poly_sin<float>{}(static_cast<float>(tX)), std::sin(static_cast<float>(tX)), 4e-7f);
+        EXPECT_NEAR(poly_cos<float>{}(static_cast<float>(tX)), std::cos(static_cast<float>(tX)), 4e-7f);
+    }
+    EXPECT_NEAR(poly_sin<double>{}(1e6), std::sin(1e6), 1e-12);
+
+    for (int i = 0; i < 3600; ++i)
+    {
+        const double tAngle = (i - 1800) * std::numbers::pi / 1800;
+        for (const double tRadius : {1e-300, 1e-3, 1.0, 7e20})
+        {
+            const double tY = tRadius * std::sin(tAngle);
+            const double tX = tRadius * std::cos(tAngle);
+            const double tPhi = std::atan2(tY, tX);
+            EXPECT_NEAR(poly_atan2<double>{}(tY, tX), tPhi, 4e-16 * std::max(1.0, std::abs(tPhi)));
+            const float tPhiF = std::atan2(static_cast<float>(tY), static_cast<float>(tX));
+            if (tRadius > 1e-30 && tRadius < 1e30)
+            {
+                EXPECT_NEAR(poly_atan2<float>{}(static_cast<float>(tY), static_cast<float>(tX)), tPhiF, 4e-7f * std::max(1.0f, std::abs(tPhiF)));
+            }
+        }
+    }
+    // Small angles keep their relative accuracy.
+    EXPECT_NEAR(poly_atan2<double>{}(1e-12, 1.0), 1e-12, 1e-27);
+    EXPECT_DOUBLE_EQ(poly_atan2<double>{}(0.0, -1.0), std::numbers::pi);
+    EXPECT_DOUBLE_EQ(poly_atan2<double>{}(-0.0, -1.0), -std::numbers::pi);
+    EXPECT_DOUBLE_EQ(poly_atan2<double>{}(1.0, 0.0), std::numbers::pi / 2);
+    EXPECT_EQ(poly_atan2<double>{}(0.0, 0.0), 0.0);
+    EXPECT_TRUE(std::isnan(poly_atan2<double>{}(std::nan(""), 1.0)));
+}
+
+TEST(ComplexBatchTest, PolyRoundTrip)
+{
+    std::vector<double> tRe(1000);
+    std::vector<double> tImg(1000);
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        tRe[i] = std::cos(0.37 * i) * (1.0 + i);
+        tImg[i] = std::sin(1.13 * i) * (1.0 + i);
+    }
+    std::vector<double> tAbs(tRe.size());
+    std::vector<double> tPhi(tRe.size());
+    std::vector<double> tRe2(tRe.size());
+    std::vector<double> tImg2(tRe.size());
+
+    toPolar<double>(tRe, tImg, tAbs, tPhi, default_sqrt<double>{}, poly_atan2<double>{});
+    fromPolar<double>(tAbs, tPhi, tRe2, tImg2, poly_sin<double>{}, poly_cos<double>{});
+
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        EXPECT_NEAR(tRe2[i], tRe[i], 1e-14 * (1.0 + i));
+        EXPECT_NEAR(tImg2[i], tImg[i], 1e-14 * (1.0 + i));
+    }
+
+    // In place: the polar planes overwrite the Cartesian ones.
+    toPolar<double>(tRe2, tImg2, tRe2, tImg2, default_sqrt<double>{}, poly_atan2<double>{});
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+    {
+        EXPECT_NEAR(tRe2[i], tAbs[i], 1e-14 * (1.0 + i));
+        EXPECT_NEAR(tImg2[i], tPhi[i], 1e-14);
+    }
+}
+
+TEST(ComplexBatchTest, SizeMismatch)
+{
+    std::vector<double> tA(3);
+    std::vector<double> tB(2);
+    EXPECT_THROW(toPolar<double>(tA, tA, tA, tB), std::invalid_argument);
+    EXPECT_THROW(fromPolar<double>(tA, tB, tA, tA), std::invalid_argument);
+}
@@ -0,0 +1,63 @@
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include "ComplexCharacterization.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexCharacterizationTest, UlpError)
+{
+    EXPECT_EQ(ulpError<float>(1.0f, 1.0L), 0.0L);
+    EXPECT_EQ(ulpError<float>(std::nextafter(1.0f, 2.0f), 1.0L), 1.0L);
+    EXPECT_EQ(ulpError<double>(0.75, 0.75L + std::ldexp(1.0L, -54)), 0.5L);
+    EXPECT_EQ(ulpError<float>(std::numeric_limits<float>::denorm_min(), 0.0L), 1.0L);
+    EXPECT_EQ(ulpError<float>(std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<long double>::quiet_NaN()), 0.0L);
+    EXPECT_TRUE(std::isinf(ulpError<float>(std::numeric_limits<float>::quiet_NaN(), 1.0L)));
+}
+
+TEST(ComplexCharacterizationTest, Functors)
+{
+    const long double tPi = std::numbers::pi_v<long double>;
+    const auto tReference = [](long double _x) { return std::sin(_x); };
+    const auto tDefault = characterizeFunctor<float>("default", default_sin<float>{}, tReference, {-tPi, tPi, 4096}, 1);
+    const auto tCubic = characterizeFunctor<float>("cubic", [](float _x) { return _x - _x * _x * _x / 6; }, tReference, {-tPi, tPi, 4096}, 1);
+
+    EXPECT_EQ(tDefault.samples, 4096u);
+    EXPECT_LE(tDefault.maxUlp, 1.0L);
+    EXPECT_LE(tDefault.meanUlp, tDefault.maxUlp);
+    EXPECT_GT(tDefault.throughput, 0.0);
+    EXPECT_GT(tDefault.latency, 0.0);
+    EXPECT_GT(tCubic.maxUlp, 1e6L);
+    EXPECT_NEAR(static_cast<double>(tCubic.maxAbsolute), std::pow(std::numbers::pi, 3) / 6 - std::numbers::pi, 1e-5);
+    EXPECT_NEAR(std::abs(static_cast<double>(tCubic.worstInput)), std::numbers::pi, 1e-6);
+
+    const auto tSet = characterizeFunctorSet<double>("double", 1024, 1);
+    ASSERT_EQ(tSet.size(), 5u);
+    EXPECT_EQ(tSet[3].name, "double.sqrt");
+    for (const auto &tResult : tSet)
+        EXPECT_LE(tResult.maxUlp, 1.0L) << tResult.name;
+
+    EXPECT_THROW(static_cast<void>(characterizeFunctor<float>("empty", default_sin<float>{}, tReference, {1, 0, 16})), std::invalid_argument);
+}
+
+TEST(ComplexCharacterizationTest, ParetoFrontier)
+{
+    std::vector<FunctorCharacterization> tCandidates(5);
+    tCandidates[0] = {"exact", 0.5L, 0.1L, 0, 0, 1e8, 10, 1};
+    tCandidates[1] = {"fast", 100.0L, 10.0L, 0, 0, 1e9, 1, 1};
+    tCandidates[2] = {"dominated", 200.0L, 10.0L, 0, 0, 5e8, 2, 1};
+    tCandidates[3] = {"middle", 4.0L, 1.0L, 0, 0, 4e8, 3, 1};
+    tCandidates[4] = {"slow and exact", 0.5L, 0.1L, 0, 0, 5e7, 20, 1};
+
+    EXPECT_EQ(paretoFrontier(tCandidates), (std::vector<std::size_t>{0, 3, 1}));
+
+    std::ostringstream tReport;
+    writeCharacterizationReport(tReport, tCandidates);
+    const std::string tText = tReport.str();
+    EXPECT_NE(tText.find("middle"), std::string::npos);
+    EXPECT_EQ(std::count(tText.begin(), tText.end(), '*'), 3);
+}
@@ -0,0 +1,141 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <limits>
+#include <bit>
+#include "ComplexDemapper.h"
+#include "ComplexRandom.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    struct Case
+    {
+        Modulation modulation;
+        std::size_t pskOrder;
+        std::size_t bits;
+    };
+
+    const std::vector<Case> kCases = {{Modulation::BPSK, 0, 1}, {Modulation::QPSK, 0, 2}, {Modulation::QAM16, 0, 4}, {Modulation::QAM64, 0, 6}, {Modulation::QAM256, 0, 8}, {Modulation::PSK, 2, 1}, {Modulation::PSK, 8, 3}, {Modulation::PSK, 32, 5}, {Modulation::PSK, 256, 8}};
+
+    std::vector<std::uint8_t> makeBits(std::size_t _size)
+    {
+        std::vector<std::uint8_t> tBits(_size);
+        PhiloxStream tStream(17);
+        for (std::size_t i = 0; i < _size; ++i)
+            tBits[i] = static_cast<std::uint8_t>(tStream(i)[0] & 1u);
+        return tBits;
+    }
+}
+
+TEST(ComplexDemapperTest, Gray)
+{
+    for (std::uint32_t i = 0; i < 1024; ++i)
+    {
+        EXPECT_EQ(grayDecode(grayEncode(i)), i);
+        EXPECT_EQ(std::popcount(grayEncode(i) ^ grayEncode(i + 1)), 1);
+    }
+}
+
+TEST(ComplexDemapperTest, Constellations)
+{
+    for (const auto &tCase : kCases)
+    {
+        const ConstellationDemapper<double> tDemapper(tCase.modulation, tCase.pskOrder);
+        ASSERT_EQ(tDemapper.getBitsPerSymbol(), tCase.bits);
+        const auto tPoints = tDemapper.getPoints();
+        ASSERT_EQ(tPoints.size(), std::size_t{1} << tCase.bits);
+
+        double tEnergy = 0;
+        double tMinDistance = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < tPoints.size(); ++i)
+        {
+            tEnergy += tPoints.real(i) * tPoints.real(i) + tPoints.imag(i) * tPoints.imag(i);
+            for (std::size_t j = 0; j < i; ++j)
+                tMinDistance = std::min(tMinDistance, std::norm(std::complex<double>(tPoints.real(i) - tPoints.real(j), tPoints.imag(i) - tPoints.imag(j))));
+        }
+        EXPECT_NEAR(tEnergy / static_cast<double>(tPoints.size()), 1.0, 1e-12);
+
+        // Gray property: nearest neighbours differ in exactly one bit.
+        for (std::size_t i = 0; i < tPoints.size(); ++i)
+            for (std::size_t j = 0; j < i; ++j)
+                if (std::norm(std::complex<double>(tPoints.real(i) - tPoints.real(j), tPoints.imag(i) - tPoints.imag(j))) < tMinDistance * (1 + 1e-9))
+                {
+                    EXPECT_EQ(std::popcount(i ^ j), 1);
+                }
+    }
+    EXPECT_THROW(ConstellationDemapper<float>(Modulation::PSK, 12), std::invalid_argument);
+}
+
+TEST(ComplexDemapperTest, HardRoundTrip)
+{
+    const std::size_t tSymbols = 1000;
+    for (const auto &tCase : kCases)
+    {
+        const ConstellationDemapper<float> tDemapper(tCase.modulation, tCase.pskOrder);
+        const auto tBits = makeBits(tSymbols * tCase.bits);
+        std::vector<std::complex<float>> tSymbolsOut(tSymbols);
+        tDemapper.modulate(tBits, ComplexInterleavedSpan<float>(tSymbolsOut));
+
+        // Noise well inside the decision regions.
+        const auto tPoints = tDemapper.getPoints();
+        const float tDistance = std::abs(std::complex<float>(tPoints.real(0) - tPoints.real(1), tPoints.imag(0) - tPoints.imag(1)));
+        for (std::size_t i = 0; i < tSymbols; ++i)
+            tSymbolsOut[i] += std::polar(0.3f * tDistance, 0.7f * static_cast<float>(i));
+
+        std::vector<std::uint8_t> tDecided(tBits.size());
+        tDemapper.demapHard(ComplexInterleavedSpan<const float>(tSymbolsOut), tDecided);
+        EXPECT_EQ(tDecided, tBits);
+
+        std::vector<std::uint32_t> tLabels(tSymbols);
+        tDemapper.demapSymbols(ComplexInterleavedSpan<const float>(tSymbolsOut), tLabels);
+        for (std::size_t i = 0; i < tSymbols; ++i)
+        {
+            std::uint32_t tLabel = 0;
+            for (std::size_t b = 0; b < tCase.bits; ++b)
+                tLabel = (tLabel << 1) | tBits[i * tCase.bits + b];
+            EXPECT_EQ(tLabels[i], tLabel);
+        }
+    }
+}
+
+TEST(ComplexDemapperTest, SoftMatchesBruteForce)
+{
+    const std::size_t tSymbols = 300;
+    const double tNoise = 0.2;
+    for (const auto &tCase : kCases)
+    {
+        const ConstellationDemapper<double> tDemapper(tCase.modulation, tCase.pskOrder, 3);
+        const auto tBits = makeBits(tSymbols * tCase.bits);
+        std::vector<std::complex<double>> tReceived(tSymbols);
+        tDemapper.modulate(tBits, ComplexInterleavedSpan<double>(tReceived));
+        std::vector<std::complex<double>> tNoiseSamples(tSymbols);
+        PhiloxStream tStream(23);
+        generateComplexGaussian(ComplexInterleavedSpan<double>(tNoiseSamples), tStream, tNoise);
+        for (std::size_t i = 0; i < tSymbols; ++i)
+            tReceived[i] += tNoiseSamples[i];
+
+        std::vector<double> tLlrs(tBits.size());
+        tDemapper.demapSoft(ComplexInterleavedSpan<const double>(tReceived), tNoise, tLlrs);
+
+        const auto tPoints = tDemapper.getPoints();
+        for (std::size_t i = 0; i < tSymbols; ++i)
+            for (std::size_t b = 0; b < tCase.bits; ++b)
+            {
+                double tMin[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+                for (std::size_t p = 0; p < tPoints.size(); ++p)
+                {
+                    const std::size_t tBit = (p >> (tCase.bits - 1 - b)) & 1;
+                    tMin[tBit] = std::min(tMin[tBit], std::norm(tReceived[i] - std::complex<double>(tPoints.real(p), tPoints.imag(p))));
+                }
+                EXPECT_NEAR(tLlrs[i * tCase.bits + b], (tMin[1] - tMin[0]) / tNoise, 1e-9);
+            }
+    }
+
+    const ConstellationDemapper<double> tDemapper(Modulation::QPSK);
+    std::vector<std::complex<double>> tOne(1);
+    std::vector<double> tLlrs(2);
+    EXPECT_THROW(tDemapper.demapSoft(ComplexInterleavedSpan<const double>(tOne), 0.0, tLlrs), std::invalid_argument);
+    EXPECT_THROW(tDemapper.demapSoft(ComplexInterleavedSpan<const double>(tOne), 1.0, std::span<double>(tLlrs).first(1)), std::invalid_argument);
+}
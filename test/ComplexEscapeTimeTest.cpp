@@ -0,0 +1,77 @@
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include "ComplexEscapeTime.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::uint32_t referenceEscape(std::complex<double> _z, std::complex<double> _c, std::uint32_t _maxIterations)
+    {
+        std::uint32_t tCount = 0;
+        for (; tCount < _maxIterations && std::norm(_z) <= 4.0; ++tCount)
+            _z = _z * _z + _c;
+        return tCount;
+    }
+}
+
+TEST(ComplexEscapeTimeTest, Mandelbrot)
+{
+    std::vector<std::complex<double>> tPoints;
+    for (int y = -20; y <= 20; ++y)
+        for (int x = -40; x <= 20; ++x)
+            tPoints.emplace_back(0.05 * x, 0.05 * y);
+    std::vector<std::uint32_t> tIterations(tPoints.size());
+
+    EscapeTimeOptions<double> tOptions;
+    tOptions.maxIterations = 100;
+    tOptions.threads = 3;
+    tOptions.tileSize = 37;
+    escapeTime(ComplexInterleavedSpan<const double>(tPoints), tIterations, tOptions);
+
+    for (std::size_t i = 0; i < tPoints.size(); ++i)
+        EXPECT_EQ(tIterations[i], referenceEscape(0.0, tPoints[i], 100)) << tPoints[i];
+    EXPECT_EQ(tIterations[40 + 20 * 61], 100u);
+}
+
+TEST(ComplexEscapeTimeTest, Julia)
+{
+    std::vector<double> tRe;
+    std::vector<double> tImg;
+    for (int y = -15; y <= 15; ++y)
+        for (int x = -15; x <= 15; ++x)
+        {
+            tRe.push_back(0.1 * x);
+            tImg.push_back(0.1 * y);
+        }
+    std::vector<std::uint32_t> tIterations(tRe.size());
+    const Complex<double> tC{-0.8, 0.156};
+
+    escapeTime(ComplexSplitSpan<const double>(tRe.data(), tImg.data(), tRe.size()), tC, tIterations);
+
+    for (std::size_t i = 0; i < tRe.size(); ++i)
+        EXPECT_EQ(tIterations[i], referenceEscape({tRe[i], tImg[i]}, {-0.8, 0.156}, 256));
+}
+
+TEST(ComplexEscapeTimeTest, Grid)
+{
+    const std::size_t tWidth = 50;
+    const std::size_t tHeight = 30;
+    std::vector<std::uint32_t> tIterations(tWidth * tHeight);
+    EscapeTimeOptions<float> tOptions;
+    tOptions.maxIterations = 64;
+
+    escapeTimeGrid(Complex<float>{-2.0f, -1.0f}, 0.0625f, tWidth, tHeight, tIterations, tOptions);
+
+    for (std::size_t y = 0; y < tHeight; ++y)
+        for (std::size_t x = 0; x < tWidth; ++x)
+        {
+            std::complex<float> tZ{};
+            const std::complex<float> tC{-2.0f + 0.0625f * x, -1.0f + 0.0625f * y};
+            std::uint32_t tCount = 0;
+            for (; tCount < 64 && std::norm(tZ) <= 4.0f; ++tCount)
+                tZ = tZ * tZ + tC;
+            EXPECT_EQ(tIterations[y * tWidth + x], tCount);
+        }
+}
@@ -0,0 +1,169 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include "ComplexFFT.h"
+#include "ComplexFFT2D.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::vector<std::complex<double>> referenceDFT2D(const std::vector<std::complex<double>> &_in, std::size_t _rows, std::size_t _cols)
+    {
+        std::vector<std::complex<double>> tOut(_in.size());
+        for (std::size_t u = 0; u < _rows; ++u)
+            for (std::size_t v = 0; v < _cols; ++v)
+                for (std::size_t r = 0; r < _rows; ++r)
+                    for (std::size_t c = 0; c < _cols; ++c)
+                        tOut[u * _cols + v] += _in[r * _cols + c] * std::polar(1.0, -2 * std::numbers::pi * (double(u * r) / _rows + double(v * c) / _cols));
+        return tOut;
+    }
+
+    struct Planes
+    {
+        std::vector<double> re;
+        std::vector<double> img;
+
+        explicit Planes(std::size_t _size) : re(_size), img(_size) {}
+        ComplexSplitSpan<double> view() { return ComplexSplitSpan<double>(re, img); }
+    };
+}
+
+TEST(ComplexFFTTest, Transform1D)
+{
+    const std::size_t tSize = 64;
+    std::vector<std::complex<double>> tSignal(tSize);
+    for (std::size_t i = 0; i < tSize; ++i)
+        tSignal[i] = {std::sin(0.3 * i) + 0.1 * i, std::cos(1.1 * i)};
+    const auto tExpected = referenceDFT2D(tSignal, 1, tSize);
+
+    auto tData = tSignal;
+    FFTPlan<double> tPlan(tSize);
+    tPlan.transform(ComplexInterleavedSpan<double>(tData), FFTDirection::Forward);
+    for (std::size_t i = 0; i < tSize; ++i)
+    {
+        EXPECT_NEAR(tData[i].real(), tExpected[i].real(), 1e-9);
+        EXPECT_NEAR(tData[i].imag(), tExpected[i].imag(), 1e-9);
+    }
+
+    tPlan.transform(ComplexInterleavedSpan<double>(tData), FFTDirection::Inverse);
+    for (std::size_t i = 0; i < tSize; ++i)
+    {
+        EXPECT_NEAR(tData[i].real(), tSignal[i].real(), 1e-12);
+        EXPECT_NEAR(tData[i].imag(), tSignal[i].imag(), 1e-12);
+    }
+
+    EXPECT_THROW(FFTPlan<double>(12), std::invalid_argument);
+}
+
+TEST(ComplexFFTTest, Transform2D)
+{
+    const std::size_t tRows = 8;
+    const std::size_t tCols = 64;
+    std::vector<std::complex<double>> tSignal(tRows * tCols);
+    Planes tData(tRows * tCols);
+    for (std::size_t i = 0; i < tSignal.size(); ++i)
+    {
+        tSignal[i] = {std::sin(0.7 * i), std::cos(0.05 * i * i)};
+        tData.re[i] = tSignal[i].real();
+        tData.img[i] = tSignal[i].imag();
+    }
+    const auto tExpected = referenceDFT2D(tSignal, tRows, tCols);
+
+    FFT2DPlan<double> tPlan(tRows, tCols, 3);
+    tPlan.transform(tData.view(), FFTDirection::Forward);
+    for (std::size_t i = 0; i < tSignal.size(); ++i)
+    {
+        EXPECT_NEAR(tData.re[i], tExpected[i].real(), 1e-8);
+        EXPECT_NEAR(tData.img[i], tExpected[i].imag(), 1e-8);
+    }
+
+    tPlan.transform(tData.view(), FFTDirection::Inverse);
+    for (std::size_t i = 0; i < tSignal.size(); ++i)
+    {
+        EXPECT_NEAR(tData.re[i], tSignal[i].real(), 1e-12);
+        EXPECT_NEAR(tData.img[i], tSignal[i].imag(), 1e-12);
+    }
+}
+
+TEST(ComplexFFTTest, TransformReal2D)
+{
+    for (const std::size_t tRows : {std::size_t{1}, std::size_t{2}, std::size_t{16}})
+    {
+        const std::size_t tCols = 32;
+        std::vector<double> tSignal(tRows * tCols);
+        Planes tFull(tRows * tCols);
+        for (std::size_t i = 0; i < tSignal.size(); ++i)
+            tFull.re[i] = tSignal[i] = std::sin(0.31 * i) + 0.01 * i;
+
+        FFT2DPlan<double> tPlan(tRows, tCols);
+        tPlan.transform(tFull.view(), FFTDirection::Forward);
+
+        Planes tHalf(tRows * tPlan.getHalfCols());
+        tPlan.transformReal(tSignal, tHalf.view());
+        for (std::size_t r = 0; r < tRows; ++r)
+        {
+            for (std::size_t c = 0; c < tPlan.getHalfCols(); ++c)
+            {
+                EXPECT_NEAR(tHalf.re[r * tPlan.getHalfCols() + c], tFull.re[r * tCols + c], 1e-10);
+                EXPECT_NEAR(tHalf.img[r * tPlan.getHalfCols() + c], tFull.img[r * tCols + c], 1e-10);
+            }
+        }
+
+        std::vector<double> tBack(tSignal.size());
+        tPlan.inverseTransformReal(tHalf.view(), tBack);
+        for (std::size_t i = 0; i < tSignal.size(); ++i)
+            EXPECT_NEAR(tBack[i], tSignal[i], 1e-12);
+    }
+}
+
+TEST(ComplexFFTTest, TransformND)
+{
+    const std::vector<std::size_t> tShape{4, 8, 16};
+    Planes tData(4 * 8 * 16);
+    for (std::size_t i = 0; i < tData.re.size(); ++i)
+    {
+        tData.re[i] = std::sin(0.13 * i);
+        tData.img[i] = std::cos(0.71 * i);
+    }
+    Planes tReference = tData;
+
+    fftND<double>(tData.view(), tShape, FFTDirection::Forward, 2);
+
+    for (std::size_t a = 0; a < 4; ++a)
+        for (std::size_t b = 0; b < 8; b += 3)
+            for (std::size_t c = 0; c < 16; c += 5)
+            {
+                std::complex<double> tExpected{};
+                for (std::size_t x = 0; x < 4; ++x)
+                    for (std::size_t y = 0; y < 8; ++y)
+                        for (std::size_t z = 0; z < 16; ++z)
+                        {
+                            const std::size_t tIndex = (x * 8 + y) * 16 + z;
+                            tExpected += std::complex<double>(tReference.re[tIndex], tReference.img[tIndex]) *
+                                         std::polar(1.0, -2 * std::numbers::pi * (double(a * x) / 4 + double(b * y) / 8 + double(c * z) / 16));
+                        }
+                const std::size_t tIndex = (a * 8 + b) * 16 + c;
+                EXPECT_NEAR(tData.re[tIndex], tExpected.real(), 1e-9);
+                EXPECT_NEAR(tData.img[tIndex], tExpected.imag(), 1e-9);
+            }
+
+    fftND<double>(tData.view(), tShape, FFTDirection::Inverse);
+    for (std::size_t i = 0; i < tData.re.size(); ++i)
+    {
+        EXPECT_NEAR(tData.re[i], tReference.re[i], 1e-12);
+        EXPECT_NEAR(tData.img[i], tReference.img[i], 1e-12);
+    }
+}
+
+TEST(ComplexFFTTest, TransformNDInvalidShape)
+{
+    Planes tEmpty(0);
+    const std::vector<std::size_t> tZeroExtent{0, 4};
+    EXPECT_THROW(fftND<double>(tEmpty.view(), tZeroExtent, FFTDirection::Forward), std::invalid_argument);
+    EXPECT_THROW(fftND<double>(tEmpty.view(), std::vector<std::size_t>{}, FFTDirection::Forward), std::invalid_argument);
+    Planes tData(8);
+    EXPECT_THROW(fftND<double>(tData.view(), std::vector<std::size_t>{2, 2}, FFTDirection::Forward), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <numbers>
+#include "ComplexGoertzel.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::complex<double> referenceDFT(const std::vector<std::complex<double>> &_samples, std::size_t _first, std::size_t _length, double _bin)
+    {
+        std::complex<double> tResult{};
+        for (std::size_t m = 0; m < _length; ++m)
+            tResult += _samples[_first + m] * std::polar(1.0, -2 * std::numbers::pi * _bin * static_cast<double>(m) / static_cast<double>(_length));
+        return tResult;
+    }
+
+    std::vector<std::complex<double>> makeSignal(std::size_t _length)
+    {
+        std::vector<std::complex<double>> tSignal(_length);
+        for (std::size_t i = 0; i < _length; ++i)
+            tSignal[i] = std::polar(1.0, 0.3 * i) + std::complex<double>(0.5 * std::cos(1.7 * i), 0.25 * std::sin(0.05 * i * i));
+        return tSignal;
+    }
+}
+
+TEST(ComplexGoertzelTest, MatchesDFT)
+{
+    const auto tSignal = makeSignal(256);
+    const std::vector<double> tBins{0.0, 3.0, 12.0, 12.5, 63.0};
+    GoertzelBank<double> tBank(64, tBins);
+
+    std::size_t tBlock = 0;
+    tBank.process(ComplexInterleavedSpan<const double>(tSignal), [&](const GoertzelBank<double> &_bank) {
+        for (std::size_t i = 0; i < tBins.size(); ++i)
+        {
+            const auto tExpected = referenceDFT(tSignal, tBlock * 64, 64, tBins[i]);
+            EXPECT_NEAR(_bank.getBin(i).getReal(), tExpected.real(), 1e-9);
+            EXPECT_NEAR(_bank.getBin(i).getImaginary(), tExpected.imag(), 1e-9);
+        }
+        ++tBlock;
+    });
+    EXPECT_EQ(tBlock, 4u);
+    EXPECT_EQ(tBank.getBlocksCompleted(), 4u);
+}
+
+TEST(ComplexGoertzelTest, SlidingDFTMatchesDFT)
+{
+    const auto tSignal = makeSignal(1000);
+    const std::vector<std::size_t> tBins{0, 1, 7, 31};
+    SlidingDFT<double> tSliding(32, tBins, 100);
+
+    for (std::size_t n = 0; n < tSignal.size(); ++n)
+    {
+        tSliding.update(Complex<double>(tSignal[n]));
+        if (n >= 31 && n % 37 == 0)
+        {
+            for (std::size_t i = 0; i < tBins.size(); ++i)
+            {
+                const auto tExpected = referenceDFT(tSignal, n - 31, 32, static_cast<double>(tBins[i]));
+                EXPECT_NEAR(tSliding.getBins().real(i), tExpected.real(), 1e-9);
+                EXPECT_NEAR(tSliding.getBins().imag(i), tExpected.imag(), 1e-9);
+            }
+        }
+    }
+}
+
+TEST(ComplexGoertzelTest, ReanchorRemovesDrift)
+{
+    // Long float stream, checked at points between two automatic reanchors.
+    const auto tSignal = makeSignal(1000000);
+    const std::vector<std::size_t> tBins{5, 17};
+    SlidingDFT<float> tReanchored(64, tBins);
+    SlidingDFT<float> tDrifting(64, tBins, kSlidingDFTNoReanchor);
+
+    double tReanchoredError = 0;
+    double tDriftingError = 0;
+    for (std::size_t n = 0; n < tSignal.size(); ++n)
+    {
+        const float tRe = static_cast<float>(tSignal[n].real());
+        const float tImg = static_cast<float>(tSignal[n].imag());
+        tReanchored.update(tRe, tImg);
+        tDrifting.update(tRe, tImg);
+        if (n % 99991 == 99990)
+        {
+            for (std::size_t i = 0; i < tBins.size(); ++i)
+            {
+                std::vector<std::complex<double>> tWindow(64);
+                for (std::size_t m = 0; m < 64; ++m)
+                    tWindow[m] = std::complex<double>(static_cast<float>(tSignal[n - 63 + m].real()), static_cast<float>(tSignal[n - 63 + m].imag()));
+                const auto tExpected = referenceDFT(tWindow, 0, 64, static_cast<double>(tBins[i]));
+                tReanchoredError = std::max(tReanchoredError, std::abs(std::complex<double>(tReanchored.getBin(i).getReal(), tReanchored.getBin(i).getImaginary()) - tExpected));
+                tDriftingError = std::max(tDriftingError, std::abs(std::complex<double>(tDrifting.getBin(i).getReal(), tDrifting.getBin(i).getImaginary()) - tExpected));
+            }
+        }
+    }
+    EXPECT_LT(tReanchoredError, 1e-4);
+    // Without reanchoring the recursion error keeps growing with the stream length.
+    EXPECT_GT(tDriftingError, 5 * tReanchoredError);
+}
+
+TEST(ComplexGoertzelTest, InvalidArguments)
+{
+    const std::vector<std::size_t> tBins{8};
+    EXPECT_THROW(SlidingDFT<double>(8, tBins), std::invalid_argument);
+    EXPECT_THROW(GoertzelBank<double>(0, std::vector<double>{1.0}), std::invalid_argument);
+}
@@ -0,0 +1,81 @@
+#include <vector>
+#include <string>
+#include <memory_resource>
+#include "ComplexMemory.h"
+#include "ComplexFFT.h"
+#include "ComplexGoertzel.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexMemoryTest, ArenaBumpAndReset)
+{
+    ComplexArena tArena(4096);
+
+    void *tFirst = tArena.allocate(100, 8);
+    void *tSecond = tArena.allocate(256, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tSecond) % 64, 0u);
+    EXPECT_GE(static_cast<std::byte *>(tSecond) - static_cast<std::byte *>(tFirst), 100);
+    EXPECT_EQ(tArena.getBytesAllocated(), 356u);
+
+    void *tLarge = tArena.allocate(3 * ComplexArena::kHugePageSize, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tLarge) % ComplexArena::kHugePageSize, 0u);
+    const auto tCapacity = tArena.getCapacity();
+
+    tArena.reset();
+    EXPECT_EQ(tArena.getBytesAllocated(), 0u);
+    EXPECT_EQ(tArena.allocate(100, 8), tFirst);
+    EXPECT_EQ(tArena.getCapacity(), tCapacity);
+
+    tArena.release();
+    EXPECT_EQ(tArena.getCapacity(), 0u);
+}
+
+TEST(ComplexMemoryTest, PoolRecyclesSizeClasses)
+{
+    ComplexPool tPool(4096, 8192);
+
+    void *tFirst = tPool.allocate(1000, 8);
+    tPool.deallocate(tFirst, 1000, 8);
+    void *tSecond = tPool.allocate(1024, 16);
+    EXPECT_EQ(tFirst, tSecond);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tSecond) % ComplexPool::kMinClassSize, 0u);
+    tPool.deallocate(tSecond, 1024, 16);
+
+    void *tLarge = tPool.allocate(10000, 8);
+    tPool.deallocate(tLarge, 10000, 8);
+}
+
+TEST(ComplexMemoryTest, ContainersUseResource)
+{
+    ComplexArena tArena;
+    ComplexPool tPool(std::size_t{1} << 16, std::size_t{1} << 16, &tArena);
+
+    PmrComplexBuffer<double> tBuffer(64, &tPool);
+    tBuffer.store(3, Complex<double>{8.0, -7.0});
+    EXPECT_DOUBLE_EQ(tBuffer.load(3).getAbsolute(), 10.63014581273465);
+    EXPECT_EQ(tBuffer.get_allocator().resource(), &tPool);
+
+    const FFTPlan<double> tPlan(64, &tArena);
+    tPlan.transform(tBuffer.view(), FFTDirection::Forward);
+    EXPECT_DOUBLE_EQ(tBuffer.real(0), 8.0);
+
+    const std::vector<std::size_t> tBins{1, 2};
+    SlidingDFT<double> tSliding(16, tBins, 0, &tArena);
+    tSliding.update(1.0, 0.0);
+    EXPECT_GT(tArena.getBytesAllocated(), 64 * 2 * sizeof(double));
+}
+
+TEST(ComplexMemoryTest, ToStringWithAllocator)
+{
+    const Complex<double> tPositive{8.0, 7.5};
+    const Complex<double> tNegative{8.0, -7.0};
+    const Complex<int> tInteger{3, -4};
+
+    ComplexArena tArena;
+    const std::pmr::string tText = tNegative.toString(std::pmr::polymorphic_allocator<char>(&tArena));
+    EXPECT_EQ(std::string(tText), tNegative.toString());
+    EXPECT_GT(tArena.getBytesAllocated(), 0u);
+
+    EXPECT_EQ(tPositive.toString(std::allocator<char>()), tPositive.toString());
+    EXPECT_EQ(tInteger.toString(std::allocator<char>()), tInteger.toString());
+}
@@ -0,0 +1,81 @@
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <numeric>
+#include <algorithm>
+#include "ComplexParallel.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexParallelTest, ChunksCoverRange)
+{
+    std::vector<int> tHits(1000, 0);
+    std::mutex tMutex;
+    std::vector<std::pair<std::size_t, std::size_t>> tRanges;
+    complexParallelFor(tHits.size(), 4, [&](std::size_t _begin, std::size_t _end)
+                       {
+        for (std::size_t i = _begin; i < _end; ++i)
+            ++tHits[i];
+        const std::lock_guard tLock(tMutex);
+        tRanges.emplace_back(_begin, _end); });
+
+    EXPECT_EQ(std::accumulate(tHits.begin(), tHits.end(), 0), 1000);
+    EXPECT_EQ(*std::min_element(tHits.begin(), tHits.end()), 1);
+    std::sort(tRanges.begin(), tRanges.end());
+    const std::vector<std::pair<std::size_t, std::size_t>> tExpected{{0, 250}, {250, 500}, {500, 750}, {750, 1000}};
+    EXPECT_EQ(tRanges, tExpected);
+}
+
+TEST(ComplexParallelTest, GrainRunsSmallCountsInline)
+{
+    std::size_t tCalls = 0;
+    complexParallelFor(100, 8, [&](std::size_t _begin, std::size_t _end)
+                       {
+        ++tCalls;
+        EXPECT_EQ(_begin, 0u);
+        EXPECT_EQ(_end, 100u);
+        EXPECT_EQ(complexWorkerIndex(), 0u); }, 64);
+    EXPECT_EQ(tCalls, 1u);
+
+    std::atomic<std::size_t> tChunks{0};
+    complexParallelFor(256, 8, [&](std::size_t _begin, std::size_t _end)
+                       {
+        EXPECT_GE(_end - _begin, 64u);
+        ++tChunks; }, 64);
+    EXPECT_EQ(tChunks.load(), 4u);
+}
+
+TEST(ComplexParallelTest, WorkersPersist)
+{
+    complexParallelFor(64, 4, [](std::size_t, std::size_t) {});
+    const std::size_t tWorkers = ComplexThreadPool::instance().getWorkerCount();
+    EXPECT_GE(tWorkers, 3u);
+
+    for (int r = 0; r < 200; ++r)
+        complexParallelFor(64, 4, [&](std::size_t, std::size_t)
+                           { EXPECT_LE(complexWorkerIndex(), tWorkers); });
+    EXPECT_EQ(ComplexThreadPool::instance().getWorkerCount(), tWorkers);
+}
+
+TEST(ComplexParallelTest, NestedCallsAndExceptions)
+{
+    std::atomic<std::size_t> tInner{0};
+    complexParallelFor(8, 4, [&](std::size_t _begin, std::size_t _end)
+                       {
+        for (std::size_t i = _begin; i < _end; ++i)
+            complexParallelFor(100, 4, [&](std::size_t _innerBegin, std::size_t _innerEnd)
+                               { tInner += _innerEnd - _innerBegin; }); });
+    EXPECT_EQ(tInner.load(), 800u);
+
+    EXPECT_THROW(complexParallelFor(100, 4, [](std::size_t _begin, std::size_t)
+                                    {
+        if (_begin >= 50)
+            throw std::runtime_error("chunk failed"); }),
+                 std::runtime_error);
+    // The pool is still usable afterwards.
+    std::atomic<std::size_t> tCount{0};
+    complexParallelFor(100, 4, [&](std::size_t _begin, std::size_t _end)
+                       { tCount += _end - _begin; });
+    EXPECT_EQ(tCount.load(), 100u);
+}
@@ -0,0 +1,107 @@
+#include <vector>
+#include <thread>
+#include <string>
+#include <sstream>
+#include <cmath>
+#include "ComplexPerf.h"
+#include "ComplexReduce.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexPerfTest, RegionsPerThread)
+{
+    PerfRegistry::instance().reset();
+    {
+        PerfRegion tOuter("outer", 100);
+        for (int i = 0; i < 3; ++i)
+        {
+            PerfRegion tInner("inner");
+            tInner.setElements(10);
+        }
+    }
+    // Threads outside the pool share worker index 0.
+    std::thread([]
+                { PerfRegion tRegion("inner", 5); })
+        .join();
+
+    const auto tResults = PerfRegistry::instance().getResults();
+    ASSERT_EQ(tResults.size(), 2u);
+    EXPECT_EQ(tResults[0].region, "inner");
+    EXPECT_EQ(tResults[0].thread, 0u);
+    EXPECT_EQ(tResults[0].counters.calls, 4u);
+    EXPECT_EQ(tResults[0].counters.elements, 35u);
+    EXPECT_EQ(tResults[1].region, "outer");
+    EXPECT_EQ(tResults[1].counters.calls, 1u);
+    EXPECT_EQ(tResults[1].counters.elements, 100u);
+    EXPECT_GE(tResults[1].counters.seconds, 0.0);
+
+    // Pool workers keep their index across parallel calls, so repeated calls do not add registry entries.
+    for (int tCall = 0; tCall < 50; ++tCall)
+    {
+        complexParallelFor(4, 4, [](std::size_t _begin, std::size_t _end)
+                           { PerfRegion tRegion("chunk", _end - _begin); });
+    }
+    const auto tChunks = PerfRegistry::instance().getResults();
+    std::size_t tChunkEntries = 0;
+    for (const auto &tResult : tChunks)
+    {
+        if (tResult.region != "chunk")
+            continue;
+        ++tChunkEntries;
+        EXPECT_LE(tResult.thread, ComplexThreadPool::instance().getWorkerCount());
+    }
+    EXPECT_GE(tChunkEntries, 1u);
+    EXPECT_LE(tChunkEntries, ComplexThreadPool::instance().getWorkerCount() + 1);
+    EXPECT_EQ(PerfRegistry::instance().getTotal("chunk").calls, 200u);
+    EXPECT_EQ(PerfRegistry::instance().getTotal("chunk").elements, 200u);
+
+    // Counters are either valid or reported as missing, never made up.
+    const auto &tGroup = perfThreadCounters();
+    for (std::size_t i = 0; i < kPerfEventCount; ++i)
+    {
+        const auto tEvent = static_cast<PerfEvent>(i);
+        EXPECT_EQ(tResults[1].counters.isValid(tEvent), tGroup.isValid(tEvent));
+        if (!tResults[1].counters.isValid(tEvent))
+        {
+            EXPECT_TRUE(std::isnan(tResults[1].counters.perElement(tEvent)));
+        }
+    }
+    if (!tGroup.isValid(PerfEvent::Cycles))
+    {
+        EXPECT_TRUE(std::isnan(tResults[1].counters.ipc()));
+    }
+    // The raw FP assist event is only programmed where its encoding is known.
+    if (perfFPAssistConfig() == 0)
+    {
+        EXPECT_FALSE(tGroup.isValid(PerfEvent::FPAssists));
+    }
+}
+
+TEST(ComplexPerfTest, Json)
+{
+    PerfRegistry::instance().reset();
+    {
+        PerfRegion tRegion("quote\"d", 4);
+    }
+    std::ostringstream tJson;
+    PerfRegistry::instance().writeJson(tJson);
+    const std::string tText = tJson.str();
+    EXPECT_EQ(tText.rfind("{\"regions\":[{\"region\":\"quote\\\"d\",\"thread\":", 0), 0u);
+    EXPECT_NE(tText.find("\"elements\":4,"), std::string::npos);
+    EXPECT_NE(tText.find("\"cyclesPerElement\":"), std::string::npos);
+    EXPECT_EQ(tText.substr(tText.size() - 3), "}]}");
+
+    PerfRegistry::instance().reset();
+    std::ostringstream tEmpty;
+    PerfRegistry::instance().writeJson(tEmpty);
+    EXPECT_EQ(tEmpty.str(), "{\"regions\":[]}");
+}
+
+TEST(ComplexPerfTest, KernelRegionsDisabledByDefault)
+{
+    PerfRegistry::instance().reset();
+    const std::vector<double> tRe(4096, 1.0);
+    const std::vector<double> tImg(4096, 2.0);
+    EXPECT_EQ(reduceSum(ComplexSplitSpan<const double>(tRe, tImg)).getReal(), 4096.0);
+    EXPECT_TRUE(PerfRegistry::instance().getResults().empty());
+}
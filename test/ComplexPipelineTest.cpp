@@ -0,0 +1,164 @@
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include "ComplexPipeline.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr std::size_t kBlocks = 100;
+    constexpr std::size_t kBlockSize = 256;
+
+    double sampleValue(std::size_t _sequence, std::size_t _index)
+    {
+        return static_cast<double>(_sequence * 1000 + _index);
+    }
+}
+
+TEST(ComplexPipelineTest, StagesSeeEveryBlockInOrder)
+{
+    ComplexPipeline<double> tPipeline(kBlockSize, 2, 4);
+    std::vector<const double *> tFilled(kBlocks, nullptr);
+    std::size_t tExpected = 0;
+    bool tValid = true;
+    bool tZeroCopy = true;
+
+    tPipeline
+        .source("capture", [&](ComplexBlock<double> &_block)
+                {
+            if (_block.sequence == kBlocks)
+                return false;
+            auto tView = _block.data.view();
+            for (std::size_t i = 0; i < tView.size(); ++i)
+                tView.set(i, sampleValue(_block.sequence, i), -1.0);
+            tFilled[_block.sequence] = &_block.data.real(0);
+            return true; })
+        .stage("scale", [](ComplexBlock<double> &_block)
+               {
+            auto tView = _block.data.view();
+            for (std::size_t i = 0; i < tView.size(); ++i)
+                tView.set(i, 2 * tView.real(i), 2 * tView.imag(i)); })
+        .stage("conjugate", [](ComplexBlock<double> &_block)
+               {
+            auto tView = _block.data.view();
+            for (std::size_t i = 0; i < tView.size(); ++i)
+                tView.set(i, tView.real(i), -tView.imag(i)); })
+        .sink("write", [&](const ComplexBlock<double> &_block)
+              {
+            tValid = tValid && _block.sequence == tExpected++ && _block.data.size() == kBlockSize;
+            tZeroCopy = tZeroCopy && tFilled[_block.sequence] == &_block.data.real(0);
+            for (std::size_t i = 0; i < _block.data.size(); ++i)
+                tValid = tValid && _block.data.real(i) == 2 * sampleValue(_block.sequence, i) && _block.data.imag(i) == 2.0; });
+    tPipeline.run();
+
+    EXPECT_TRUE(tValid);
+    EXPECT_TRUE(tZeroCopy);
+    EXPECT_EQ(tExpected, kBlocks);
+    // In flight: 3 channels of 2 blocks, one block per stage and the one the source is filling.
+    EXPECT_LE(tPipeline.getAllocatedBlocks(), 3u * 2u + 4u + 1u);
+
+    const auto &tMetrics = tPipeline.getMetrics();
+    ASSERT_EQ(tMetrics.size(), 4u);
+    EXPECT_EQ(tMetrics[0].name, "capture");
+    EXPECT_EQ(tMetrics[3].name, "write");
+    for (const auto &tStage : tMetrics)
+    {
+        EXPECT_EQ(tStage.blocks, kBlocks);
+        EXPECT_EQ(tStage.samples, kBlocks * kBlockSize);
+        EXPECT_GE(tStage.busySeconds, 0.0);
+        EXPECT_GE(tStage.maxBlockSeconds * static_cast<double>(tStage.blocks), tStage.busySeconds * 0.999);
+    }
+    EXPECT_GT(tPipeline.getWallSeconds(), 0.0);
+}
+
+TEST(ComplexPipelineTest, SlowSinkIsBottleneckAndThrottlesSource)
+{
+    ComplexPipeline<float> tPipeline(64, 1, 2);
+    std::size_t tBlocks = 0;
+    tPipeline
+        .source("capture", [](ComplexBlock<float> &_block)
+                { return _block.sequence < 20; })
+        .stage("pass", [](ComplexBlock<float> &) {})
+        .sink("slow", [&](const ComplexBlock<float> &)
+              {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            ++tBlocks; });
+    tPipeline.run();
+
+    EXPECT_EQ(tBlocks, 20u);
+    EXPECT_EQ(tPipeline.getBottleneck(), 2u);
+    const auto &tMetrics = tPipeline.getMetrics();
+    // The source spends its time blocked on the full channel, the sink almost never waits for input.
+    EXPECT_GT(tMetrics[0].outputWaitSeconds, tMetrics[0].busySeconds);
+    EXPECT_GT(tMetrics[2].busySeconds, 0.02);
+    EXPECT_GT(tMetrics[2].throughput(), 0.0);
+    EXPECT_NEAR(tMetrics[2].latency(), tMetrics[2].busySeconds / 20, 1e-12);
+    EXPECT_LE(tPipeline.getAllocatedBlocks(), 2u * 1u + 3u + 1u);
+}
+
+TEST(ComplexPipelineTest, PartialBlocksAndRepeatedRuns)
+{
+    ComplexPipeline<double> tPipeline(16, 3, 1);
+    std::size_t tSamples = 0;
+    tPipeline
+        .source("capture", [](ComplexBlock<double> &_block)
+                {
+            if (_block.sequence == 5)
+                return false;
+            if (_block.sequence == 4)
+                _block.data.resize(7);
+            return true; })
+        .sink("count", [&](const ComplexBlock<double> &_block)
+              { tSamples += _block.data.size(); });
+
+    tPipeline.run();
+    EXPECT_EQ(tSamples, 4u * 16u + 7u);
+    const std::size_t tAllocated = tPipeline.getAllocatedBlocks();
+
+    tSamples = 0;
+    tPipeline.run();
+    EXPECT_EQ(tSamples, 4u * 16u + 7u);
+    EXPECT_EQ(tPipeline.getMetrics()[1].samples, 4u * 16u + 7u);
+    // The second run is served from the pool.
+    EXPECT_EQ(tPipeline.getAllocatedBlocks(), tAllocated);
+}
+
+TEST(ComplexPipelineTest, StageExceptionStopsPipeline)
+{
+    for (std::size_t tThreads : {1u, 3u})
+    {
+        ComplexPipeline<double> tPipeline(32, 2, tThreads);
+        tPipeline
+            .source("endless", [](ComplexBlock<double> &)
+                    { return true; })
+            .stage("fails", [](ComplexBlock<double> &_block)
+                   {
+                if (_block.sequence == 5)
+                    throw std::runtime_error("stage failed"); })
+            .sink("drop", [](const ComplexBlock<double> &) {});
+        EXPECT_THROW(tPipeline.run(), std::runtime_error);
+        EXPECT_EQ(tPipeline.getMetrics()[2].blocks, 5u);
+    }
+}
+
+TEST(ComplexPipelineTest, InvalidStructure)
+{
+    EXPECT_THROW(ComplexPipeline<double>(0), std::invalid_argument);
+    EXPECT_THROW(ComplexPipeline<double>(8, 0), std::invalid_argument);
+
+    ComplexPipeline<double> tPipeline(8);
+    EXPECT_THROW(tPipeline.stage("first", [](ComplexBlock<double> &) {}), std::invalid_argument);
+    EXPECT_THROW(tPipeline.run(), std::invalid_argument);
+    tPipeline.source("source", [](ComplexBlock<double> &)
+                     { return false; });
+    EXPECT_THROW(tPipeline.source("second", [](ComplexBlock<double> &)
+                                  { return false; }),
+                 std::invalid_argument);
+    EXPECT_THROW(tPipeline.run(), std::invalid_argument);
+    tPipeline.sink("sink", [](const ComplexBlock<double> &) {});
+    EXPECT_THROW(tPipeline.sink("after", [](const ComplexBlock<double> &) {}), std::invalid_argument);
+    tPipeline.run();
+    EXPECT_EQ(tPipeline.getMetrics()[1].blocks, 0u);
+}
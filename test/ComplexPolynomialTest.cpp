@@ -0,0 +1,157 @@
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include "ComplexPolynomial.h"
+
+#include <gtest/gtest.h>
+
+using Comp = Complex<double>;
+
+namespace
+{
+    // Coefficients (ascending) of prod (z - r_i)
+    std::vector<std::complex<double>> fromRoots(const std::vector<std::complex<double>> &_roots)
+    {
+        std::vector<std::complex<double>> tCoefficients{1.0};
+        for (const auto &tRoot : _roots)
+        {
+            std::vector<std::complex<double>> tNext(tCoefficients.size() + 1);
+            for (std::size_t k = 0; k < tCoefficients.size(); ++k)
+            {
+                tNext[k + 1] += tCoefficients[k];
+                tNext[k] -= tRoot * tCoefficients[k];
+            }
+            tCoefficients = tNext;
+        }
+        return tCoefficients;
+    }
+}
+
+TEST(ComplexPolynomialTest, EvaluateSingle)
+{
+    const std::vector<Comp> tCoefficients{Comp{1.0, 0.0}, Comp{0.0, 2.0}, Comp{-3.0, 1.0}};
+    const auto tResult = evaluatePolynomial<double>(tCoefficients, Comp{8.0, -7.0});
+
+    const std::complex<double> tZ{8.0, -7.0};
+    const std::complex<double> tExpected = std::complex<double>(1.0, 0.0) + std::complex<double>(0.0, 2.0) * tZ + std::complex<double>(-3.0, 1.0) * tZ * tZ;
+    EXPECT_DOUBLE_EQ(tResult.getReal(), tExpected.real());
+    EXPECT_DOUBLE_EQ(tResult.getImaginary(), tExpected.imag());
+    EXPECT_DOUBLE_EQ(tResult.getAbsolute(), std::abs(tExpected));
+}
+
+TEST(ComplexPolynomialTest, EvaluateBatch)
+{
+    const auto tCoefficients = fromRoots({{1.0, 0.0}, {-2.0, 0.5}, {0.0, 3.0}, {0.25, -0.75}});
+    std::vector<std::complex<double>> tPoints(1000);
+    for (std::size_t i = 0; i < tPoints.size(); ++i)
+        tPoints[i] = {std::sin(0.1 * i) * 3.0, std::cos(0.37 * i) * 2.0};
+    std::vector<std::complex<double>> tOut(tPoints.size());
+
+    evaluatePolynomial(ComplexInterleavedSpan<const double>(tCoefficients), ComplexInterleavedSpan<const double>(tPoints), ComplexInterleavedSpan<double>(tOut), 4);
+
+    for (std::size_t i = 0; i < tPoints.size(); ++i)
+    {
+        std::complex<double> tExpected{};
+        for (std::size_t k = tCoefficients.size(); k-- > 0;)
+            tExpected = tExpected * tPoints[i] + tCoefficients[k];
+        EXPECT_NEAR(tOut[i].real(), tExpected.real(), 1e-9);
+        EXPECT_NEAR(tOut[i].imag(), tExpected.imag(), 1e-9);
+    }
+}
+
+TEST(ComplexPolynomialTest, FindRoots)
+{
+    const std::vector<std::complex<double>> tRoots{{1.0, 0.0}, {-2.0, 0.0}, {0.0, 3.0}, {0.5, 0.5}, {-0.25, -1.5}};
+    const auto tCoefficients = fromRoots(tRoots);
+
+    const PolynomialRootFinder<double> tFinder;
+    const auto tResult = tFinder.solve(ComplexInterleavedSpan<const double>(tCoefficients));
+    ASSERT_TRUE(tResult.converged);
+    ASSERT_EQ(tResult.roots.size(), tRoots.size());
+
+    for (const auto &tRoot : tRoots)
+    {
+        const auto tFound = std::any_of(tResult.roots.begin(), tResult.roots.end(), [&](const Comp &_root)
+                                        { return std::abs(static_cast<std::complex<double>>(_root) - tRoot) < 1e-10; });
+        EXPECT_TRUE(tFound);
+    }
+}
+
+TEST(ComplexPolynomialTest, FindRootsMultiple)
+{
+    // (z - 1)^2 (z + 2): multiple roots are only found to about sqrt(epsilon).
+    const std::vector<std::complex<double>> tCoefficients{2.0, -3.0, 0.0, 1.0};
+    const auto tResult = PolynomialRootFinder<double>(1e-12).solve(ComplexInterleavedSpan<const double>(tCoefficients));
+    ASSERT_EQ(tResult.roots.size(), 3u);
+    std::size_t tNearOne = 0;
+    std::size_t tNearMinusTwo = 0;
+    for (const auto &tRoot : tResult.roots)
+    {
+        ASSERT_TRUE(std::isfinite(tRoot.getReal()) && std::isfinite(tRoot.getImaginary()));
+        tNearOne += std::abs(static_cast<std::complex<double>>(tRoot) - 1.0) < 1e-6 ? 1 : 0;
+        tNearMinusTwo += std::abs(static_cast<std::complex<double>>(tRoot) + 2.0) < 1e-10 ? 1 : 0;
+    }
+    EXPECT_EQ(tNearOne, 2u);
+    EXPECT_EQ(tNearMinusTwo, 1u);
+
+    // z^4 (z - 2): a fourfold root at the origin, where p' vanishes as well.
+    const std::vector<std::complex<double>> tPower{0.0, 0.0, 0.0, 0.0, -2.0, 1.0};
+    const auto tPowerResult = PolynomialRootFinder<double>(1e-12).solve(ComplexInterleavedSpan<const double>(tPower));
+    std::size_t tNearZero = 0;
+    for (const auto &tRoot : tPowerResult.roots)
+    {
+        ASSERT_TRUE(std::isfinite(tRoot.getReal()) && std::isfinite(tRoot.getImaginary()));
+        tNearZero += tRoot.getAbsolute() < 1e-3 ? 1 : 0;
+    }
+    EXPECT_EQ(tNearZero, 4u);
+
+    // z^3 - 1e-300: the roots have magnitude 1e-100, so |p'|^2 and |z_i - z_j|^2 underflow although p does not,
+    // and the tolerance must stay relative to the root magnitude.
+    const std::vector<std::complex<double>> tTiny{-1e-300, 0.0, 0.0, 1.0};
+    const auto tTinyResult = PolynomialRootFinder<double>().solve(ComplexInterleavedSpan<const double>(tTiny));
+    EXPECT_TRUE(tTinyResult.converged);
+    for (const auto &tRoot : tTinyResult.roots)
+    {
+        ASSERT_TRUE(std::isfinite(tRoot.getReal()) && std::isfinite(tRoot.getImaginary()));
+        EXPECT_NEAR(tRoot.getAbsolute() * 1e100, 1.0, 1e-6);
+    }
+}
+
+TEST(ComplexPolynomialTest, FindRootsSmall)
+{
+    // z^2 - 1e-40: the roots +-1e-20 are found to the relative tolerance, not to an absolute one.
+    const std::vector<std::complex<double>> tCoefficients{-1e-40, 0.0, 1.0};
+    const auto tResult = PolynomialRootFinder<double>().solve(ComplexInterleavedSpan<const double>(tCoefficients));
+    EXPECT_TRUE(tResult.converged);
+    ASSERT_EQ(tResult.roots.size(), 2u);
+    for (const auto &tRoot : tResult.roots)
+    {
+        EXPECT_NEAR(tRoot.getAbsolute() * 1e20, 1.0, 1e-12);
+        EXPECT_NEAR(std::abs(tRoot.getImaginary()) * 1e20, 0.0, 1e-12);
+    }
+}
+
+TEST(ComplexPolynomialTest, FindRootsDeterministic)
+{
+    // z^300 - 1 has the roots of unity.
+    std::vector<std::complex<double>> tCoefficients(301);
+    tCoefficients.front() = -1.0;
+    tCoefficients.back() = 1.0;
+
+    const auto tSingle = PolynomialRootFinder<double>(1e-12, 500, 1).solve(ComplexInterleavedSpan<const double>(tCoefficients));
+    const auto tMulti = PolynomialRootFinder<double>(1e-12, 500, 4).solve(ComplexInterleavedSpan<const double>(tCoefficients));
+    ASSERT_TRUE(tSingle.converged);
+    EXPECT_EQ(tSingle.iterations, tMulti.iterations);
+    ASSERT_EQ(tSingle.roots.size(), 300u);
+    for (std::size_t i = 0; i < tSingle.roots.size(); ++i)
+    {
+        EXPECT_EQ(tSingle.roots[i], tMulti.roots[i]);
+        EXPECT_NEAR(tSingle.roots[i].getAbsolute(), 1.0, 1e-10);
+    }
+}
+
+TEST(ComplexPolynomialTest, InvalidLeadingCoefficient)
+{
+    const std::vector<std::complex<double>> tCoefficients{{1.0, 0.0}, {0.0, 0.0}};
+    EXPECT_THROW(static_cast<void>(PolynomialRootFinder<double>().solve(ComplexInterleavedSpan<const double>(tCoefficients))), std::invalid_argument);
+}
@@ -0,0 +1,100 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include "ComplexRandom.h"
+
+#include <gtest/gtest.h>
+
+TEST(ComplexRandomTest, PhiloxKnownAnswer)
+{
+    // Known answer vectors of the Random123 reference implementation.
+    const auto tZero = PhiloxStream::generate({0, 0, 0, 0}, {0, 0});
+    EXPECT_EQ(tZero, (PhiloxStream::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+
+    const auto tOnes = PhiloxStream::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    EXPECT_EQ(tOnes, (PhiloxStream::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+}
+
+TEST(ComplexRandomTest, GaussianStatistics)
+{
+    std::vector<std::complex<double>> tNoise(200000);
+    PhiloxStream tStream(42);
+    generateComplexGaussian(ComplexInterleavedSpan<double>(tNoise), tStream, 2.0);
+    EXPECT_EQ(tStream.getPosition(), tNoise.size());
+
+    std::complex<double> tMean{};
+    double tPower = 0;
+    double tRealPower = 0;
+    std::complex<double> tPseudo{};
+    for (const auto &tSample : tNoise)
+    {
+        tMean += tSample;
+        tPower += std::norm(tSample);
+        tRealPower += tSample.real() * tSample.real();
+        tPseudo += tSample * tSample;
+    }
+    const double tCount = static_cast<double>(tNoise.size());
+    EXPECT_NEAR(std::abs(tMean / tCount), 0.0, 0.01);
+    EXPECT_NEAR(tPower / tCount, 2.0, 0.02);
+    EXPECT_NEAR(tRealPower / tCount, 1.0, 0.02);
+    EXPECT_NEAR(std::abs(tPseudo / tCount), 0.0, 0.02);
+}
+
+TEST(ComplexRandomTest, DeterministicAcrossThreads)
+{
+    std::vector<double> tRe1(10000);
+    std::vector<double> tImg1(10000);
+    std::vector<double> tRe2(10000);
+    std::vector<double> tImg2(10000);
+
+    PhiloxStream tStream1(7, 3);
+    PhiloxStream tStream2(7, 3);
+    generateComplexGaussian(ComplexSplitSpan<double>(tRe1, tImg1), tStream1, 1.0, 1);
+    // Second half first and on several threads: only the stream position matters.
+    tStream2.setPosition(5000);
+    generateComplexGaussian(ComplexSplitSpan<double>(tRe2, tImg2).subspan(5000, 5000), tStream2, 1.0, 4);
+    tStream2.setPosition(0);
+    generateComplexGaussian(ComplexSplitSpan<double>(tRe2, tImg2).subspan(0, 5000), tStream2, 1.0, 3);
+
+    EXPECT_EQ(tRe1, tRe2);
+    EXPECT_EQ(tImg1, tImg2);
+
+    PhiloxStream tOther = tStream1.substream(4);
+    tOther.setPosition(0);
+    generateComplexGaussian(ComplexSplitSpan<double>(tRe2, tImg2), tOther);
+    EXPECT_NE(tRe1, tRe2);
+}
+
+TEST(ComplexRandomTest, PhasorsAndFading)
+{
+    std::vector<std::complex<float>> tPhasors(50000);
+    PhiloxStream tStream(1);
+    generatePhasors(ComplexInterleavedSpan<float>(tPhasors), tStream, 3.0f);
+    std::complex<float> tMean{};
+    for (const auto &tPhasor : tPhasors)
+    {
+        EXPECT_NEAR(std::abs(tPhasor), 3.0f, 1e-5f);
+        tMean += tPhasor;
+    }
+    EXPECT_NEAR(std::abs(tMean) / tPhasors.size(), 0.0f, 0.05f);
+
+    std::vector<std::complex<double>> tFading(200000);
+    generateRicianFading(ComplexInterleavedSpan<double>(tFading), tStream, 4.0, 2.0, 0.5);
+    std::complex<double> tLos{};
+    double tPower = 0;
+    for (const auto &tH : tFading)
+    {
+        tLos += tH;
+        tPower += std::norm(tH);
+    }
+    tLos /= static_cast<double>(tFading.size());
+    EXPECT_NEAR(tPower / tFading.size(), 2.0, 0.02);
+    EXPECT_NEAR(std::norm(tLos), 2.0 * 4.0 / 5.0, 0.02);
+    EXPECT_NEAR(std::arg(tLos), 0.5, 0.02);
+
+    generateRayleighFading(ComplexInterleavedSpan<double>(tFading), tStream, 0.5);
+    tPower = 0;
+    for (const auto &tH : tFading)
+        tPower += std::norm(tH);
+    EXPECT_NEAR(tPower / tFading.size(), 0.5, 0.005);
+}
@@ -0,0 +1,84 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include "ComplexReduce.h"
+#include "ComplexRandom.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::vector<std::complex<double>> makeSignal(std::size_t _size)
+    {
+        std::vector<std::complex<double>> tSignal(_size);
+        PhiloxStream tStream(11);
+        generateComplexGaussian(ComplexInterleavedSpan<double>(tSignal), tStream, 4.0);
+        for (auto &tSample : tSignal)
+            tSample += std::complex<double>(1.5, -0.5);
+        return tSignal;
+    }
+}
+
+TEST(ComplexReduceTest, SumMeanPowerVariance)
+{
+    const auto tSignal = makeSignal(100003);
+    const ComplexInterleavedSpan<const double> tView(tSignal);
+
+    long double tRe = 0;
+    long double tImg = 0;
+    long double tEnergy = 0;
+    for (const auto &tSample : tSignal)
+    {
+        tRe += tSample.real();
+        tImg += tSample.imag();
+        tEnergy += std::norm(tSample);
+    }
+    const long double tCount = tSignal.size();
+    long double tDeviation = 0;
+    for (const auto &tSample : tSignal)
+        tDeviation += std::norm(std::complex<long double>(tSample.real(), tSample.imag()) - std::complex<long double>(tRe / tCount, tImg / tCount));
+
+    const auto tSum = reduceSum(tView);
+    EXPECT_NEAR(tSum.getReal(), static_cast<double>(tRe), 1e-9);
+    EXPECT_NEAR(tSum.getImaginary(), static_cast<double>(tImg), 1e-9);
+
+    const auto tMean = reduceMean(tView);
+    EXPECT_NEAR(tMean.getReal(), 1.5, 0.02);
+    EXPECT_NEAR(tMean.getImaginary(), -0.5, 0.02);
+    EXPECT_DOUBLE_EQ(reducePower(tView), static_cast<double>(tEnergy / tCount));
+    EXPECT_DOUBLE_EQ(reduceVariance(tView), static_cast<double>(tDeviation / tCount));
+    EXPECT_NEAR(reduceVariance(tView), 4.0, 0.05);
+}
+
+TEST(ComplexReduceTest, BitIdenticalAcrossThreads)
+{
+    const auto tSignal = makeSignal(65537);
+    const ComplexInterleavedSpan<const double> tView(tSignal);
+
+    const auto tReference = reduceSum(tView, 1);
+    const auto tPower = reducePower(tView, 1);
+    const auto tVariance = reduceVariance(tView, 1);
+    for (const std::size_t tThreads : {2, 3, 7, 16})
+    {
+        EXPECT_EQ(reduceSum(tView, tThreads), tReference);
+        EXPECT_EQ(reducePower(tView, tThreads), tPower);
+        EXPECT_EQ(reduceVariance(tView, tThreads), tVariance);
+    }
+}
+
+TEST(ComplexReduceTest, MagnitudeExtrema)
+{
+    auto tSignal = makeSignal(5000);
+    tSignal[1234] = {30.0, -40.0};
+    tSignal[4321] = {0.0, 1e-3};
+    tSignal[4999] = {-30.0, 40.0};
+    const ComplexInterleavedSpan<const double> tView(tSignal);
+
+    EXPECT_DOUBLE_EQ(reduceMaxMagnitude(tView, 4), 50.0);
+    EXPECT_EQ(reduceArgMaxMagnitude(tView, 4), 1234u);
+    EXPECT_DOUBLE_EQ(reduceMinMagnitude(tView), 1e-3);
+    EXPECT_EQ(reduceMagnitudeExtrema(tView).argMin, 4321u);
+
+    EXPECT_THROW((void)reduceArgMaxMagnitude(ComplexInterleavedSpan<const double>()), std::invalid_argument);
+    EXPECT_EQ(reduceSum(ComplexInterleavedSpan<const double>()), Complex<double>());
+}
@@ -0,0 +1,168 @@
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+#include "ComplexSpectral.h"
+#include "ComplexRandom.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::vector<std::complex<double>> makeTone(std::size_t _size, double _frequency, double _amplitude)
+    {
+        std::vector<std::complex<double>> tSignal(_size);
+        for (std::size_t i = 0; i < _size; ++i)
+            tSignal[i] = std::polar(_amplitude, 2 * std::numbers::pi * _frequency * static_cast<double>(i));
+        return tSignal;
+    }
+}
+
+TEST(ComplexSpectralTest, Windows)
+{
+    const auto tHann = makeWindow<double>(WindowType::Hann, 8);
+    EXPECT_NEAR(tHann[0], 0.0, 1e-15);
+    EXPECT_NEAR(tHann[4], 1.0, 1e-15);
+    EXPECT_NEAR(tHann[2], 0.5, 1e-15);
+    const auto tBlackman = makeWindow<double>(WindowType::Blackman, 8);
+    EXPECT_NEAR(tBlackman[0], 0.0, 1e-15);
+    EXPECT_NEAR(tBlackman[4], 1.0, 1e-15);
+    EXPECT_NEAR(makeWindow<double>(WindowType::Hamming, 8)[0], 0.08, 1e-15);
+    for (const auto tValue : makeWindow<double>(WindowType::Rectangular, 8))
+        EXPECT_EQ(tValue, 1.0);
+}
+
+TEST(ComplexSpectralTest, WelchToneAndChunking)
+{
+    const std::size_t tLength = 64;
+    const auto tSignal = makeTone(5000, 8.0 / tLength, 2.0);
+
+    SpectralOptions<double> tOptions;
+    tOptions.segmentLength = tLength;
+    tOptions.overlap = 48;
+    tOptions.window = WindowType::Rectangular;
+    tOptions.sampleRate = 1000;
+
+    WelchEstimator<double> tWhole(tOptions);
+    tWhole.push(ComplexInterleavedSpan<const double>(tSignal));
+    EXPECT_EQ(tWhole.getSegmentCount(), (tSignal.size() - tLength) / 16 + 1);
+
+    // |X[8]|^2 = (2 N)^2, density scaling divides by fs * N
+    const auto tPsd = tWhole.getPsd();
+    EXPECT_NEAR(tPsd[8], 4.0 * tLength / 1000, 1e-9);
+    for (std::size_t k = 0; k < tLength; ++k)
+    {
+        if (k != 8)
+        {
+            EXPECT_NEAR(tPsd[k], 0.0, 1e-9);
+        }
+    }
+
+    // Pushing in uneven pieces and on a single thread gives bit-identical results.
+    tOptions.threads = 1;
+    WelchEstimator<double> tChunked(tOptions);
+    const ComplexInterleavedSpan<const double> tView(tSignal);
+    for (std::size_t tFirst = 0, tStep = 1; tFirst < tSignal.size(); tFirst += tStep, tStep = tStep * 3 % 257 + 1)
+        tChunked.push(tView.subspan(tFirst, std::min(tStep, tSignal.size() - tFirst)));
+    EXPECT_EQ(tChunked.getSegmentCount(), tWhole.getSegmentCount());
+    const auto tChunkedPsd = tChunked.getPsd();
+    for (std::size_t k = 0; k < tLength; ++k)
+        EXPECT_EQ(tChunkedPsd[k], tPsd[k]);
+
+    tChunked.reset();
+    EXPECT_EQ(tChunked.getSegmentCount(), 0u);
+    EXPECT_EQ(tChunked.getPsd()[8], 0.0);
+
+    tOptions.overlap = tLength;
+    EXPECT_THROW(WelchEstimator<double>{tOptions}, std::invalid_argument);
+}
+
+TEST(ComplexSpectralTest, WelchNoiseParseval)
+{
+    std::vector<std::complex<double>> tNoise(1 << 16);
+    PhiloxStream tStream(5);
+    generateComplexGaussian(ComplexInterleavedSpan<double>(tNoise), tStream, 2.0);
+
+    SpectralOptions<double> tOptions;
+    tOptions.segmentLength = 256;
+    tOptions.overlap = 128;
+    WelchEstimator<double> tWelch(tOptions);
+    tWelch.push(ComplexInterleavedSpan<const double>(tNoise));
+
+    // White noise: flat density whose integral over the band is the variance.
+    double tTotal = 0;
+    for (const auto tValue : tWelch.getPsd())
+    {
+        EXPECT_NEAR(tValue, 2.0, 0.5);
+        tTotal += tValue / 256;
+    }
+    EXPECT_NEAR(tTotal, 2.0, 0.05);
+}
+
+TEST(ComplexSpectralTest, AveragingModes)
+{
+    const std::size_t tLength = 32;
+    auto tSignal = makeTone(tLength * 4, 4.0 / tLength, 1.0);
+    // The second segment carries twice the amplitude.
+    for (std::size_t i = tLength; i < 2 * tLength; ++i)
+        tSignal[i] *= 2.0;
+
+    SpectralOptions<double> tOptions;
+    tOptions.segmentLength = tLength;
+    tOptions.overlap = 0;
+    tOptions.window = WindowType::Rectangular;
+
+    tOptions.averaging = SpectralAveraging::Peak;
+    WelchEstimator<double> tPeak(tOptions);
+    tPeak.push(ComplexInterleavedSpan<const double>(tSignal));
+    EXPECT_NEAR(tPeak.getPsd()[4], 4.0 * tLength, 1e-9);
+
+    tOptions.averaging = SpectralAveraging::Exponential;
+    tOptions.exponentialFactor = 0.5;
+    WelchEstimator<double> tExponential(tOptions);
+    tExponential.push(ComplexInterleavedSpan<const double>(tSignal));
+    // 1, then (1 + 4) / 2, then (2.5 + 1) / 2, then (1.75 + 1) / 2
+    EXPECT_NEAR(tExponential.getPsd()[4], 1.375 * tLength, 1e-9);
+
+    tOptions.averaging = SpectralAveraging::Mean;
+    WelchEstimator<double> tMean(tOptions);
+    tMean.push(ComplexInterleavedSpan<const double>(tSignal));
+    EXPECT_NEAR(tMean.getPsd()[4], 1.75 * tLength, 1e-9);
+}
+
+TEST(ComplexSpectralTest, SpectrogramRows)
+{
+    const std::size_t tLength = 16;
+    std::vector<std::complex<double>> tSignal;
+    for (std::size_t tBin = 1; tBin <= 6; ++tBin)
+    {
+        const auto tTone = makeTone(2 * tLength, static_cast<double>(tBin) / tLength, 1.0);
+        tSignal.insert(tSignal.end(), tTone.begin(), tTone.end());
+    }
+
+    SpectralOptions<double> tOptions;
+    tOptions.segmentLength = tLength;
+    tOptions.overlap = 0;
+    tOptions.window = WindowType::Rectangular;
+    tOptions.segmentsPerRow = 2;
+    Spectrogram<double> tSpectrogram(tOptions);
+
+    std::vector<std::size_t> tPeaks;
+    const ComplexInterleavedSpan<const double> tView(tSignal);
+    const auto tOnRow = [&](std::size_t _row, std::span<const double> _psd)
+    {
+        EXPECT_EQ(_row, tPeaks.size());
+        ASSERT_EQ(_psd.size(), tLength);
+        tPeaks.push_back(static_cast<std::size_t>(std::max_element(_psd.begin(), _psd.end()) - _psd.begin()));
+        EXPECT_NEAR(_psd[tPeaks.back()], static_cast<double>(tLength), 1e-9);
+    };
+    tSpectrogram.push(tView.subspan(0, 40), tOnRow);
+    EXPECT_EQ(tSpectrogram.getRowCount(), 1u);
+    tSpectrogram.push(tView.subspan(40, tSignal.size() - 40), tOnRow);
+    EXPECT_EQ(tSpectrogram.getRowCount(), 6u);
+    EXPECT_EQ(tPeaks, (std::vector<std::size_t>{1, 2, 3, 4, 5, 6}));
+
+    tOptions.segmentsPerRow = 0;
+    EXPECT_THROW(Spectrogram<double>{tOptions}, std::invalid_argument);
+}
@@ -0,0 +1,88 @@
+#include <array>
+#include <complex>
+#include <cmath>
+#include "ComplexVec.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using Vec3 = ComplexVec<double, 3>;
+    using Mat2 = ComplexMat<double, 2, 2>;
+
+    constexpr Vec3 kA({1, 2, 3}, {0, -1, 2});
+    constexpr Vec3 kB({0, 1, -1}, {1, 1, 0});
+
+    // Element-wise operations and products are usable at compile time.
+    static_assert((kA + kB) == Vec3({1, 3, 2}, {1, 0, 2}));
+    static_assert((kA - kB) == Vec3({1, 1, 4}, {-1, -2, 2}));
+    static_assert((kA * kB) == Vec3({0, 3, -3}, {1, 1, -2}));
+    static_assert((kA * 2.0) == Vec3({2, 4, 6}, {0, -2, 4}));
+    static_assert(kA.conjugate() == Vec3({1, 2, 3}, {0, 1, -2}));
+    static_assert(kA.norm() == 19);
+    static_assert(dot<double, 3, std::complex<double>>(kA, kB) == std::complex<double>(-2, 6));
+    static_assert(dotu<double, 3, std::complex<double>>(kA, kB) == std::complex<double>(0, 0));
+
+    constexpr Mat2 kM({1, 2, 3, 4}, {1, 0, 0, -1});
+    static_assert((Mat2::identity() * kM) == kM);
+    static_assert((kM * Mat2::identity()) == kM);
+    static_assert(kM.transpose().real(0, 1) == 3 && kM.transpose().imag(1, 1) == -1);
+    static_assert(kM.hermitian().imag(0, 0) == -1);
+    static_assert((ComplexMat<double, 2, 2>({0, 1, 1, 0}, {0, 0, 0, 0}).inverse()) == ComplexMat<double, 2, 2>({0, 1, 1, 0}, {0, 0, 0, 0}));
+    static_assert((ComplexMat<double, 1, 1>({0}, {2}).inverse()) == ComplexMat<double, 1, 1>({0}, {-0.5}));
+}
+
+TEST(ComplexVecTest, ComplexInterop)
+{
+    const std::array<Complex<double>, 2> tValues = {Complex<double>(1, 2), Complex<double>(-3, 0.5)};
+    ComplexVec<double, 2> tVec(tValues);
+    EXPECT_EQ(tVec.load(1).getReal(), -3);
+    EXPECT_EQ(tVec.load(1).getImaginary(), 0.5);
+
+    tVec *= Complex<double>(0, 1);
+    EXPECT_EQ(tVec.real(0), -2);
+    EXPECT_EQ(tVec.imag(0), 1);
+
+    tVec.store(0, Complex<double>(4, 4));
+    EXPECT_EQ(tVec.view().real(0), 4);
+    const auto tDot = dot(tVec, tVec);
+    EXPECT_DOUBLE_EQ(tDot.getReal(), tVec.norm());
+    EXPECT_DOUBLE_EQ(tDot.getImaginary(), 0);
+}
+
+TEST(ComplexVecTest, MatrixProducts)
+{
+    const ComplexMat<double, 2, 3> tA({1, 2, 3, 4, 5, 6}, {1, 0, -1, 0, 2, 0});
+    const ComplexMat<double, 3, 1> tB({1, 0, 2}, {0, 1, 0});
+    const auto tProduct = tA * tB;
+    static_assert(std::is_same_v<std::remove_const_t<decltype(tProduct)>, ComplexMat<double, 2, 1>>);
+    // row 0: (1+i) * 1 + 2 * i + (3-i) * 2 = 7 + i
+    EXPECT_EQ(tProduct.real(0, 0), 7);
+    EXPECT_EQ(tProduct.imag(0, 0), 1);
+    // row 1: 4 + (5+2i) * i + 12 = 14 + 5i
+    EXPECT_EQ(tProduct.real(1, 0), 14);
+    EXPECT_EQ(tProduct.imag(1, 0), 5);
+
+    const auto tVec = tA * ComplexVec<double, 3>({1, 0, 2}, {0, 1, 0});
+    EXPECT_EQ(tVec.real(0), 7);
+    EXPECT_EQ(tVec.imag(1), 5);
+}
+
+TEST(ComplexVecTest, Inverse)
+{
+    ComplexMat<double, 4, 4> tMat;
+    for (std::size_t r = 0; r < 4; ++r)
+        for (std::size_t c = 0; c < 4; ++c)
+            tMat.set(r, c, 1.0 / static_cast<double>(1 + r + c), std::sin(static_cast<double>(r * c + 1)));
+
+    const auto tIdentity = tMat * tMat.inverse();
+    for (std::size_t r = 0; r < 4; ++r)
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            EXPECT_NEAR(tIdentity.real(r, c), r == c ? 1.0 : 0.0, 1e-12);
+            EXPECT_NEAR(tIdentity.imag(r, c), 0.0, 1e-12);
+        }
+
+    const ComplexMat<double, 2, 2> tSingular({1, 2, 2, 4}, {1, 2, 2, 4});
+    EXPECT_THROW(static_cast<void>(tSingular.inverse()), std::invalid_argument);
+}
@@ -0,0 +1,84 @@
+#include <vector>
+#include <complex>
+#include "ComplexView.h"
+#include "ComplexBatch.h"
+
+#include <gtest/gtest.h>
+
+using Comp = Complex<double>;
+
+TEST(ComplexViewTest, StdComplexConversion)
+{
+    const std::complex<double> tStd{8.0, -7.0};
+
+    Comp tNumber = tStd;
+    EXPECT_DOUBLE_EQ(tNumber.getReal(), 8.0);
+    EXPECT_DOUBLE_EQ(tNumber.getImaginary(), -7.0);
+    EXPECT_DOUBLE_EQ(tNumber.getAbsolute(), 10.63014581273465);
+    EXPECT_DOUBLE_EQ(tNumber.getPhi(), -0.71882999962162453);
+
+    const auto tBack = static_cast<std::complex<double>>(tNumber);
+    EXPECT_EQ(tBack, tStd);
+
+    const auto tSum = tNumber + tStd;
+    EXPECT_DOUBLE_EQ(tSum.getReal(), 16.0);
+    EXPECT_DOUBLE_EQ(tSum.getImaginary(), -14.0);
+}
+
+TEST(ComplexViewTest, InterleavedStdComplex)
+{
+    std::vector<std::complex<double>> tData{{1.0, 2.0}, {3.0, -4.0}};
+    ComplexInterleavedSpan<double> tView(tData);
+
+    ASSERT_EQ(tView.size(), 2u);
+    EXPECT_DOUBLE_EQ(tView.real(1), 3.0);
+    EXPECT_DOUBLE_EQ(tView.imag(1), -4.0);
+    EXPECT_DOUBLE_EQ(tView.load(1).getAbsolute(), 5.0);
+
+    tView.store(0, Comp{8.0, -7.0});
+    EXPECT_EQ(tData[0], std::complex<double>(8.0, -7.0));
+
+    const ComplexInterleavedSpan<const double> tConstView = tView;
+    EXPECT_DOUBLE_EQ(tConstView.real(0), 8.0);
+    EXPECT_DOUBLE_EQ(tConstView.subspan(1, 1).imag(0), -4.0);
+}
+
+TEST(ComplexViewTest, RawInterleavedAndSplit)
+{
+    double tRaw[6] = {1.0, 1.0, 2.0, -2.0, -3.0, 0.5};
+    std::vector<double> tRe(3);
+    std::vector<double> tImg(3);
+
+    copyView(ComplexInterleavedSpan<const double>(tRaw, 3), ComplexSplitSpan<double>(tRe, tImg));
+    EXPECT_EQ(tRe, (std::vector<double>{1.0, 2.0, -3.0}));
+    EXPECT_EQ(tImg, (std::vector<double>{1.0, -2.0, 0.5}));
+
+    EXPECT_THROW(ComplexSplitSpan<double>(std::span<double>(tRe), std::span<double>(tImg).first(2)), std::invalid_argument);
+}
+
+TEST(ComplexViewTest, BatchKernelsOnViews)
+{
+    std::vector<std::complex<double>> tLh{{8.0, -7.0}, {0.0, 2.0}, {-1.0, 0.0}};
+    std::vector<std::complex<double>> tRh{{8.0, -7.0}, {1.0, 1.0}, {2.0, 3.0}};
+    std::vector<std::complex<double>> tOut(3);
+
+    batchMultiply(ComplexInterleavedSpan<const double>(tLh), ComplexInterleavedSpan<const double>(tRh), ComplexInterleavedSpan<double>(tOut));
+    for (std::size_t i = 0; i < tOut.size(); ++i)
+        EXPECT_EQ(tOut[i], tLh[i] * tRh[i]);
+
+    batchAdd(ComplexInterleavedSpan<const double>(tLh), ComplexInterleavedSpan<const double>(tRh), ComplexInterleavedSpan<double>(tOut));
+    for (std::size_t i = 0; i < tOut.size(); ++i)
+        EXPECT_EQ(tOut[i], tLh[i] + tRh[i]);
+
+    batchConjugate(ComplexInterleavedSpan<const double>(tLh), ComplexInterleavedSpan<double>(tLh));
+    EXPECT_EQ(tLh[0], std::complex<double>(8.0, 7.0));
+
+    std::vector<double> tAbs(3);
+    std::vector<double> tPhi(3);
+    toPolar(ComplexInterleavedSpan<const double>(tRh), std::span<double>(tAbs), std::span<double>(tPhi));
+    for (std::size_t i = 0; i < tRh.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(tAbs[i], std::abs(tRh[i]));
+        EXPECT_DOUBLE_EQ(tPhi[i], std::arg(tRh[i]));
+    }
+}